@@ -10,7 +10,8 @@ public class EditorActorTagDisplay : ModuleRules
         PublicDependencyModuleNames.AddRange(new string[] {
             "Core",
             "CoreUObject",
-            "Engine"
+            "Engine",
+            "EditorSubsystem"
         });
 
         PrivateDependencyModuleNames.AddRange(new string[] {
@@ -19,7 +20,12 @@ public class EditorActorTagDisplay : ModuleRules
             "Slate",
             "SlateCore",
             "DeveloperSettings",
-            "ToolMenus"
+            "ToolMenus",
+            "RenderCore",
+            "RHI",
+            "Json",
+            "AssetRegistry",
+            "GameplayTags"
         });
     }
 }
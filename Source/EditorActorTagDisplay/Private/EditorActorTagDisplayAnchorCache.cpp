@@ -0,0 +1,215 @@
+#include "EditorActorTagDisplayAnchorCache.h"
+#include "EditorActorTagDisplaySettings.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+FEditorActorTagDisplayAnchorCache::~FEditorActorTagDisplayAnchorCache()
+{
+    Reset();
+}
+
+auto FEditorActorTagDisplayAnchorCache::GetAnchor(AActor *Actor, const FActorClassTagDisplayConfig &Config) -> FVector
+{
+    // NOLINTNEXTLINE
+    check(Actor != nullptr);
+
+    if (!FEditorActorTagDisplayAnchorCache::CanCacheAnchor(Actor, Config))
+    {
+        return FEditorActorTagDisplayAnchorCache::ComputeAnchor(Actor, Config);
+    }
+
+    FEntry &Entry = Entries.FindOrAdd(Actor);
+    if (!Entry.bIsValid)
+    {
+        Entry.Anchor = FEditorActorTagDisplayAnchorCache::ComputeAnchor(Actor, Config);
+        Entry.bIsValid = true;
+        BindTransformUpdated(Entry, Actor, Config);
+    }
+    return Entry.Anchor;
+}
+
+auto FEditorActorTagDisplayAnchorCache::Invalidate(const TWeakObjectPtr<AActor> &Actor) -> bool
+{
+    FEntry *Entry = Entries.Find(Actor);
+    if (Entry == nullptr)
+    {
+        return false;
+    }
+
+    Entry->bIsValid = false;
+    return true;
+}
+
+auto FEditorActorTagDisplayAnchorCache::InvalidateAll() -> void
+{
+    for (auto &Pair : Entries)
+    {
+        Pair.Value.bIsValid = false;
+    }
+}
+
+auto FEditorActorTagDisplayAnchorCache::Remove(const TWeakObjectPtr<AActor> &Actor) -> void
+{
+    FEntry Entry;
+    if (Entries.RemoveAndCopyValue(Actor, Entry))
+    {
+        FEditorActorTagDisplayAnchorCache::UnbindTransformUpdated(Entry);
+    }
+}
+
+auto FEditorActorTagDisplayAnchorCache::Reset() -> void
+{
+    for (auto &Pair : Entries)
+    {
+        FEditorActorTagDisplayAnchorCache::UnbindTransformUpdated(Pair.Value);
+    }
+    Entries.Reset();
+}
+
+auto FEditorActorTagDisplayAnchorCache::ComputeAnchor(const AActor *Actor, const FActorClassTagDisplayConfig &Config)
+    -> FVector
+{
+    // NOLINTNEXTLINE
+    check(Actor != nullptr);
+
+    const FVector ActorLocation = Actor->GetActorLocation();
+
+    switch (Config.AnchorSource)
+    {
+    case EEditorActorTagDisplayAnchorSource::AllPrimitiveBounds:
+        return FEditorActorTagDisplayAnchorCache::GetBoundsTopCenter(Actor->GetComponentsBoundingBox(true),
+                                                                     ActorLocation);
+
+    case EEditorActorTagDisplayAnchorSource::RootLocation:
+        return ActorLocation;
+
+    case EEditorActorTagDisplayAnchorSource::Socket:
+    {
+        // ソケットを持つ最初のコンポーネントを使い、見つからなければアクターの原点位置を使用
+        TInlineComponentArray<USceneComponent *> SceneComponents(Actor);
+        for (const USceneComponent *SceneComponent : SceneComponents)
+        {
+            if (SceneComponent != nullptr && SceneComponent->DoesSocketExist(Config.AnchorSocketName))
+            {
+                return SceneComponent->GetSocketLocation(Config.AnchorSocketName);
+            }
+        }
+        return ActorLocation;
+    }
+
+    case EEditorActorTagDisplayAnchorSource::CollidingBounds:
+    default:
+        return FEditorActorTagDisplayAnchorCache::GetBoundsTopCenter(Actor->GetComponentsBoundingBox(false),
+                                                                     ActorLocation);
+    }
+}
+
+auto FEditorActorTagDisplayAnchorCache::GetBoundsTopCenter(const FBox &Bounds, const FVector &Fallback) -> FVector
+{
+    // バウンディングボックスがない場合は、アクターの原点位置を使用
+    if (Bounds.IsValid == 0U)
+    {
+        return Fallback;
+    }
+
+    FVector BoundingCenter;
+    FVector BoundingExtents;
+    Bounds.GetCenterAndExtents(BoundingCenter, BoundingExtents);
+
+    const auto HalfHeight = static_cast<float>(FVector::DotProduct(BoundingExtents, FVector::UpVector));
+    return BoundingCenter + FVector::UpVector * HalfHeight;
+}
+
+auto FEditorActorTagDisplayAnchorCache::CanCacheAnchor(const AActor *Actor, const FActorClassTagDisplayConfig &Config)
+    -> bool
+{
+    // NOLINTNEXTLINE
+    check(Actor != nullptr);
+
+    switch (Config.AnchorSource)
+    {
+    case EEditorActorTagDisplayAnchorSource::RootLocation:
+        return true;
+
+    case EEditorActorTagDisplayAnchorSource::CollidingBounds:
+        // コリジョンを持つコンポーネントの登録・解除は物理状態の作成・破棄として通知される
+        return true;
+
+    default:
+    {
+        // コリジョンのないコンポーネントの登録・解除は通知されない
+        // エディターではトランザクションかコンストラクションスクリプトの再実行を伴うため検出できるが、
+        // ゲームワールドでは通知なしに変わるため毎回計算する
+        const UWorld *World = Actor->GetWorld();
+        return World == nullptr || !World->IsGameWorld();
+    }
+    }
+}
+
+auto FEditorActorTagDisplayAnchorCache::BindTransformUpdated(FEntry &Entry, AActor *Actor,
+                                                             const FActorClassTagDisplayConfig &Config) -> void
+{
+    // NOLINTNEXTLINE
+    check(Actor != nullptr);
+
+    // コンポーネントの構成は再計算のたびに変わり得るため購読し直す
+    FEditorActorTagDisplayAnchorCache::UnbindTransformUpdated(Entry);
+
+    // ルートの位置以外は子コンポーネント単独の移動（ソケットを持つ子・子のプリミティブ）でも変わる
+    TInlineComponentArray<USceneComponent *> SceneComponents;
+    if (Config.AnchorSource == EEditorActorTagDisplayAnchorSource::RootLocation)
+    {
+        if (USceneComponent *RootComponent = Actor->GetRootComponent())
+        {
+            SceneComponents.Add(RootComponent);
+        }
+    }
+    else
+    {
+        Actor->GetComponents(SceneComponents);
+    }
+
+    for (USceneComponent *SceneComponent : SceneComponents)
+    {
+        if (SceneComponent != nullptr)
+        {
+            FBoundComponent &Bound = Entry.BoundComponents.AddDefaulted_GetRef();
+            Bound.Component = SceneComponent;
+            Bound.TransformUpdatedHandle =
+                SceneComponent->TransformUpdated.AddRaw(this, &FEditorActorTagDisplayAnchorCache::OnTransformUpdated);
+        }
+    }
+}
+
+auto FEditorActorTagDisplayAnchorCache::UnbindTransformUpdated(FEntry &Entry) -> void
+{
+    for (const FBoundComponent &Bound : Entry.BoundComponents)
+    {
+        if (USceneComponent *Component = Bound.Component.Get())
+        {
+            Component->TransformUpdated.Remove(Bound.TransformUpdatedHandle);
+        }
+    }
+    Entry.BoundComponents.Reset();
+}
+
+auto FEditorActorTagDisplayAnchorCache::OnTransformUpdated(USceneComponent *UpdatedComponent,
+                                                           EUpdateTransformFlags /*UpdateTransformFlags*/,
+                                                           ETeleportType /*Teleport*/) -> void
+{
+    AActor *Actor = UpdatedComponent != nullptr ? UpdatedComponent->GetOwner() : nullptr;
+    if (Actor == nullptr)
+    {
+        return;
+    }
+
+    // 既に無効化済みであれば、同じフレーム内の連続した移動で何度も通知しない
+    FEntry *Entry = Entries.Find(Actor);
+    if (Entry == nullptr || !Entry->bIsValid)
+    {
+        return;
+    }
+
+    Entry->bIsValid = false;
+    OnAnchorInvalidated.ExecuteIfBound(Actor);
+}
@@ -0,0 +1,17 @@
+#include "EditorActorTagDisplayBatchActor.h"
+
+AEditorActorTagDisplayBatchActor::AEditorActorTagDisplayBatchActor()
+{
+    PrimaryActorTick.bCanEverTick = false;
+
+    // Create batch component at the world origin so label positions can be used as world positions
+    BatchComponent = CreateDefaultSubobject<UEditorActorTagDisplayBatchComponent>(TEXT("BatchComponent"));
+    RootComponent = BatchComponent;
+
+    // Set as transient to prevent saving
+    SetFlags(RF_Transient);
+
+    // Configure for editor display
+    SetActorHiddenInGame(false);    // Show in PIE
+    SetActorEnableCollision(false); // Disable collision
+}
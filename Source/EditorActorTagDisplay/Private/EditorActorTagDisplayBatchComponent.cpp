@@ -0,0 +1,539 @@
+#include "EditorActorTagDisplayBatchComponent.h"
+#include "Components/TextRenderComponent.h"
+#include "DynamicMeshBuilder.h"
+#include "Engine/Font.h"
+#include "Engine/Texture2D.h"
+#include "LocalVertexFactory.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Materials/MaterialInterface.h"
+#include "Materials/MaterialRenderProxy.h"
+#include "PrimitiveSceneProxy.h"
+#include "RenderingThread.h"
+#include "SceneManagement.h"
+#include "SceneView.h"
+#include "StaticMeshResources.h"
+
+namespace
+{
+/** ラベルの一覧から作った頂点バッファを、ビューとフレームをまたいで再利用するシーンプロキシ */
+class FEditorActorTagDisplayBatchSceneProxy final : public FPrimitiveSceneProxy
+{
+public:
+    FEditorActorTagDisplayBatchSceneProxy(const UEditorActorTagDisplayBatchComponent *Component,
+                                          UMaterialInterface *Material,
+                                          TArray<FEditorActorTagDisplayBatchLabel> &&InLabels, float InGlyphScale,
+                                          const FRotator &InFacingRotation)
+        : FPrimitiveSceneProxy(Component), MaterialRenderProxy(Material->GetRenderProxy()),
+          MaterialRelevance(Material->GetRelevance_Concurrent(GetScene().GetShaderPlatform())),
+          VertexFactory(GetScene().GetFeatureLevel(), "FEditorActorTagDisplayBatchSceneProxy"),
+          InitialLabels(MoveTemp(InLabels)), InitialGlyphScale(InGlyphScale), InitialFacingRotation(InFacingRotation)
+    {
+        bWillEverBeLit = false;
+    }
+
+    ~FEditorActorTagDisplayBatchSceneProxy() override
+    {
+        VertexBuffers.PositionVertexBuffer.ReleaseResource();
+        VertexBuffers.StaticMeshVertexBuffer.ReleaseResource();
+        VertexBuffers.ColorVertexBuffer.ReleaseResource();
+        IndexBuffer.ReleaseResource();
+        VertexFactory.ReleaseResource();
+    }
+
+    auto GetTypeHash() const -> SIZE_T override
+    {
+        static size_t UniquePointer;
+        return reinterpret_cast<size_t>(&UniquePointer);
+    }
+
+    auto GetMemoryFootprint() const -> uint32 override { return sizeof(*this) + GetAllocatedSize(); }
+
+    auto CreateRenderThreadResources(FRHICommandListBase &RHICmdList) -> void override
+    {
+        BuildMesh(RHICmdList, InitialLabels, InitialGlyphScale, InitialFacingRotation);
+        InitialLabels.Empty();
+    }
+
+    auto GetViewRelevance(const FSceneView *View) const -> FPrimitiveViewRelevance override
+    {
+        FPrimitiveViewRelevance Result;
+        Result.bDrawRelevance = IsShown(View);
+        Result.bDynamicRelevance = true;
+        Result.bShadowRelevance = false;
+        Result.bRenderInMainPass = ShouldRenderInMainPass();
+        Result.bEditorPrimitiveRelevance = UseEditorCompositing(View);
+        MaterialRelevance.SetPrimitiveViewRelevance(Result);
+        return Result;
+    }
+
+    auto GetDynamicMeshElements(const TArray<const FSceneView *> &Views, const FSceneViewFamily & /*ViewFamily*/,
+                                uint32 VisibilityMap, FMeshElementCollector &Collector) const -> void override
+    {
+        if (NumTriangles == 0 || MaterialRenderProxy == nullptr)
+        {
+            return;
+        }
+
+        // 頂点の生成は行わず、作成済みのバッファを参照するメッシュを追加するだけにする
+        for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ++ViewIndex)
+        {
+            if ((VisibilityMap & (1U << ViewIndex)) == 0U)
+            {
+                continue;
+            }
+
+            FMeshBatch &Mesh = Collector.AllocateMesh();
+            FMeshBatchElement &BatchElement = Mesh.Elements[0];
+            BatchElement.IndexBuffer = &IndexBuffer;
+            BatchElement.FirstIndex = 0;
+            BatchElement.NumPrimitives = NumTriangles;
+            BatchElement.MinVertexIndex = 0;
+            BatchElement.MaxVertexIndex = NumVertices - 1;
+            Mesh.VertexFactory = &VertexFactory;
+            Mesh.MaterialRenderProxy = MaterialRenderProxy;
+            Mesh.ReverseCulling = IsLocalToWorldDeterminantNegative();
+            Mesh.bDisableBackfaceCulling = true;
+            Mesh.Type = PT_TriangleList;
+            Mesh.DepthPriorityGroup = SDPG_World;
+            Mesh.bCanApplyViewModeOverrides = false;
+            Collector.AddMesh(ViewIndex, Mesh);
+        }
+    }
+
+    /** ラベルの一覧か向きが変わったフレームに、1回のレンダーコマンドから頂点バッファを作り直す */
+    auto SetLabels_RenderThread(FRHICommandListBase &RHICmdList, const TArray<FEditorActorTagDisplayBatchLabel> &Labels,
+                                float GlyphScale, const FRotator &FacingRotation) -> void
+    {
+        // NOLINTNEXTLINE
+        check(IsInRenderingThread());
+        BuildMesh(RHICmdList, Labels, GlyphScale, FacingRotation);
+    }
+
+private:
+    auto BuildMesh(FRHICommandListBase &RHICmdList, const TArray<FEditorActorTagDisplayBatchLabel> &Labels,
+                   float GlyphScale, const FRotator &FacingRotation) -> void
+    {
+        // カメラの右・上方向にクアッドを張り、頂点はプリミティブのローカル空間で持つ
+        const FMatrix WorldToLocal = GetLocalToWorld().Inverse();
+        const FRotationMatrix FacingMatrix(FacingRotation);
+        const FVector3f TangentX(WorldToLocal.TransformVector(FacingMatrix.GetScaledAxis(EAxis::Y)).GetSafeNormal());
+        const FVector3f Up(WorldToLocal.TransformVector(FacingMatrix.GetScaledAxis(EAxis::Z)).GetSafeNormal());
+        const FVector3f TangentZ(-WorldToLocal.TransformVector(FacingMatrix.GetScaledAxis(EAxis::X)).GetSafeNormal());
+        const FVector3f Right = TangentX * GlyphScale;
+        const FVector3f ScaledUp = Up * GlyphScale;
+
+        int32 NumGlyphs = 0;
+        for (const FEditorActorTagDisplayBatchLabel &Label : Labels)
+        {
+            NumGlyphs += Label.Glyphs->Num();
+        }
+
+        TArray<FDynamicMeshVertex> Vertices;
+        TArray<uint32> Indices;
+        Vertices.Reserve(NumGlyphs * 4);
+        Indices.Reserve(NumGlyphs * 6);
+        for (const FEditorActorTagDisplayBatchLabel &Label : Labels)
+        {
+            const FVector3f Origin(WorldToLocal.TransformPosition(Label.Position));
+            const auto AddCorner = [&](float X, float Y, float U, float V) -> void
+            {
+                Vertices.Emplace(Origin + Right * X + ScaledUp * Y, TangentX, TangentZ, FVector2f(U, V), Label.Color);
+            };
+
+            for (const FEditorActorTagDisplayGlyphQuad &Glyph : *Label.Glyphs)
+            {
+                const auto BaseIndex = static_cast<uint32>(Vertices.Num());
+                AddCorner(Glyph.OffsetMin.X, Glyph.OffsetMax.Y, Glyph.UVMin.X, Glyph.UVMin.Y);
+                AddCorner(Glyph.OffsetMax.X, Glyph.OffsetMax.Y, Glyph.UVMax.X, Glyph.UVMin.Y);
+                AddCorner(Glyph.OffsetMax.X, Glyph.OffsetMin.Y, Glyph.UVMax.X, Glyph.UVMax.Y);
+                AddCorner(Glyph.OffsetMin.X, Glyph.OffsetMin.Y, Glyph.UVMin.X, Glyph.UVMax.Y);
+                Indices.Append({BaseIndex, BaseIndex + 1, BaseIndex + 2, BaseIndex, BaseIndex + 2, BaseIndex + 3});
+            }
+        }
+
+        NumVertices = static_cast<uint32>(Vertices.Num());
+        NumTriangles = static_cast<uint32>(Indices.Num() / 3);
+        if (Vertices.IsEmpty())
+        {
+            return;
+        }
+
+        // 既存のバッファは内容を差し替えて再利用する
+        VertexBuffers.InitFromDynamicVertex(&VertexFactory, Vertices);
+        IndexBuffer.Indices = MoveTemp(Indices);
+        if (IndexBuffer.IsInitialized())
+        {
+            IndexBuffer.UpdateRHI(RHICmdList);
+        }
+        else
+        {
+            IndexBuffer.InitResource(RHICmdList);
+        }
+    }
+
+    FMaterialRenderProxy *MaterialRenderProxy;
+    FMaterialRelevance MaterialRelevance;
+
+    FStaticMeshVertexBuffers VertexBuffers;
+    FDynamicMeshIndexBuffer32 IndexBuffer;
+    FLocalVertexFactory VertexFactory;
+    uint32 NumVertices = 0;
+    uint32 NumTriangles = 0;
+
+    /** レンダースレッドのリソース作成時に使う、作成時点のラベル */
+    TArray<FEditorActorTagDisplayBatchLabel> InitialLabels;
+    float InitialGlyphScale;
+    FRotator InitialFacingRotation;
+};
+} // namespace
+
+UEditorActorTagDisplayBatchComponent::UEditorActorTagDisplayBatchComponent()
+{
+    PrimaryComponentTick.bCanEverTick = false;
+
+    SetMobility(EComponentMobility::Movable);
+    SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    SetGenerateOverlapEvents(false);
+    SetCastShadow(false);
+    bSelectable = false;
+
+    // TextRenderComponentと同じフォントを使用して表示を揃える
+    Font = GetDefault<UTextRenderComponent>()->Font;
+}
+
+auto UEditorActorTagDisplayBatchComponent::SupportsFont(const UFont *InFont) -> bool
+{
+    // ランタイム・コンポジットフォントはアトラスを持たず、複数ページのアトラスは1つのマテリアルで参照できない
+    return InFont != nullptr && InFont->FontCacheType == EFontCacheType::Offline && InFont->Textures.Num() == 1 &&
+           InFont->Textures[0] != nullptr;
+}
+
+auto UEditorActorTagDisplayBatchComponent::AddLabel() -> int32
+{
+    // 文字列が設定されるまでは描画されないため、描画データは送り直さない
+    return Labels.Add(FEditorActorTagDisplayBatchLabel());
+}
+
+auto UEditorActorTagDisplayBatchComponent::RemoveLabel(int32 LabelId) -> void
+{
+    if (!Labels.IsValidIndex(LabelId))
+    {
+        return;
+    }
+
+    ReleaseGlyphRun(Labels[LabelId]);
+    Labels.RemoveAt(LabelId);
+    MarkLabelsDirty(true);
+}
+
+auto UEditorActorTagDisplayBatchComponent::SetLabelText(int32 LabelId, const FString &Text) -> bool
+{
+    if (!Labels.IsValidIndex(LabelId))
+    {
+        return false;
+    }
+
+    // 同じ文字列のラベルは、最初に作ったグリフ配置を共有する（ハッシュの衝突で別の文字列を描かないよう文字列で引く）
+    bool bBuilt = false;
+    int32 &TextId = InternedTextIds.FindOrAdd(Text, INDEX_NONE);
+    if (TextId == INDEX_NONE)
+    {
+        FEditorActorTagDisplayGlyphRun Glyphs;
+        BuildGlyphs(Text, Glyphs);
+
+        FInternedGlyphRun GlyphRun;
+        GlyphRun.Text = Text;
+        for (const FEditorActorTagDisplayGlyphQuad &Glyph : Glyphs)
+        {
+            const FVector2f FarCorner = FVector2f::Max(Glyph.OffsetMin.GetAbs(), Glyph.OffsetMax.GetAbs());
+            GlyphRun.Extent = FMath::Max(GlyphRun.Extent, FarCorner.Size());
+        }
+        GlyphRun.Glyphs = MakeShared<const FEditorActorTagDisplayGlyphRun, ESPMode::ThreadSafe>(MoveTemp(Glyphs));
+        TextId = InternedGlyphRuns.Add(MoveTemp(GlyphRun));
+        bBuilt = true;
+    }
+    AssignGlyphRun(Labels[LabelId], TextId);
+    MarkLabelsDirty(true);
+    return bBuilt;
+}
+
+auto UEditorActorTagDisplayBatchComponent::GetLabelNumGlyphs(int32 LabelId) const -> int32
+{
+    if (!Labels.IsValidIndex(LabelId) || !Labels[LabelId].Glyphs.IsValid())
+    {
+        return 0;
+    }
+    return Labels[LabelId].Glyphs->Num();
+}
+
+auto UEditorActorTagDisplayBatchComponent::AssignGlyphRun(FEditorActorTagDisplayBatchLabel &Label, int32 TextId)
+    -> void
+{
+    if (Label.TextId == TextId)
+    {
+        return;
+    }
+
+    // 解放で配置が消えないよう、先に参照を増やす
+    FInternedGlyphRun &GlyphRun = InternedGlyphRuns[TextId];
+    ++GlyphRun.NumLabels;
+    const FEditorActorTagDisplayGlyphRunPtr Glyphs = GlyphRun.Glyphs;
+    ReleaseGlyphRun(Label);
+    Label.TextId = TextId;
+    Label.Glyphs = Glyphs;
+}
+
+auto UEditorActorTagDisplayBatchComponent::ReleaseGlyphRun(FEditorActorTagDisplayBatchLabel &Label) -> void
+{
+    if (Label.TextId == INDEX_NONE)
+    {
+        return;
+    }
+
+    FInternedGlyphRun &GlyphRun = InternedGlyphRuns[Label.TextId];
+    if (--GlyphRun.NumLabels <= 0)
+    {
+        // レンダースレッドが参照中の配置は共有ポインタにより描画が終わるまで保持される
+        InternedTextIds.Remove(GlyphRun.Text);
+        InternedGlyphRuns.RemoveAt(Label.TextId);
+    }
+    Label.TextId = INDEX_NONE;
+    Label.Glyphs.Reset();
+}
+
+auto UEditorActorTagDisplayBatchComponent::SetLabelPosition(int32 LabelId, const FVector &Position) -> void
+{
+    if (!Labels.IsValidIndex(LabelId))
+    {
+        return;
+    }
+
+    Labels[LabelId].Position = Position;
+    MarkLabelsDirty(true);
+}
+
+auto UEditorActorTagDisplayBatchComponent::SetLabelColor(int32 LabelId, FColor Color) -> void
+{
+    if (!Labels.IsValidIndex(LabelId))
+    {
+        return;
+    }
+
+    Labels[LabelId].Color = Color;
+    MarkLabelsDirty(false);
+}
+
+auto UEditorActorTagDisplayBatchComponent::SetTextSize(float InTextSize) -> void
+{
+    // グリフはフォント単位で保持しているため、共有中の配置は作り直さずにスケールだけを送り直す
+    TextSize = InTextSize;
+    MarkLabelsDirty(true);
+}
+
+auto UEditorActorTagDisplayBatchComponent::SetFacingRotation(const FRotator &Rotation) -> void
+{
+    // カメラの平行移動では向きが変わらないため、頂点バッファを作り直さない
+    if (FacingRotation.Equals(Rotation, FacingRotationTolerance))
+    {
+        return;
+    }
+
+    FacingRotation = Rotation;
+    MarkLabelsDirty(false);
+}
+
+auto UEditorActorTagDisplayBatchComponent::MarkLabelsDirty(bool bBoundsChanged) -> void
+{
+    MarkRenderDynamicDataDirty();
+
+    // トランスフォームの送信時にCalcBoundsで範囲を計算し直させる
+    if (bBoundsChanged)
+    {
+        MarkRenderTransformDirty();
+    }
+}
+
+auto UEditorActorTagDisplayBatchComponent::SetTextMaterial(UMaterialInterface *InMaterial) -> void
+{
+    if (InMaterial == nullptr)
+    {
+        TextMaterialInstance = nullptr;
+        MarkRenderStateDirty();
+        return;
+    }
+
+    TextMaterialInstance = UMaterialInstanceDynamic::Create(InMaterial, this);
+    if (TextMaterialInstance != nullptr && Font != nullptr)
+    {
+        // フォントパラメータにラベル用フォントのアトラスを割り当てる
+        TArray<FMaterialParameterInfo> FontParameterInfos;
+        TArray<FGuid> FontParameterIds;
+        InMaterial->GetAllParameterInfoOfType(EMaterialParameterType::Font, FontParameterInfos, FontParameterIds);
+        for (const FMaterialParameterInfo &ParameterInfo : FontParameterInfos)
+        {
+            TextMaterialInstance->SetFontParameterValue(ParameterInfo, Font, 0);
+        }
+    }
+    MarkRenderStateDirty();
+}
+
+auto UEditorActorTagDisplayBatchComponent::CreateSceneProxy() -> FPrimitiveSceneProxy *
+{
+    UMaterialInterface *Material = GetMaterial(0);
+    if (Material == nullptr)
+    {
+        return nullptr;
+    }
+    return new FEditorActorTagDisplayBatchSceneProxy(this, Material, GatherRenderLabels(), GetGlyphScale(),
+                                                     FacingRotation);
+}
+
+auto UEditorActorTagDisplayBatchComponent::CalcBounds(const FTransform &LocalToWorld) const -> FBoxSphereBounds
+{
+    // ラベルはワールド座標で保持しているため、基準位置をグリフの最大距離だけ広げた範囲を合成する
+    // （クアッドはカメラに向けて回転するため、向きによらない範囲にする）
+    const float GlyphScale = GetGlyphScale();
+    FBox Bounds(ForceInit);
+    for (const FEditorActorTagDisplayBatchLabel &Label : Labels)
+    {
+        if (Label.TextId != INDEX_NONE)
+        {
+            const double Extent = InternedGlyphRuns[Label.TextId].Extent * GlyphScale;
+            Bounds += FBox::BuildAABB(Label.Position, FVector(Extent));
+        }
+    }
+
+    if (Bounds.IsValid == 0U)
+    {
+        return {LocalToWorld.GetLocation(), FVector::ZeroVector, 0.0};
+    }
+    return {Bounds};
+}
+
+auto UEditorActorTagDisplayBatchComponent::GetMaterial(int32 ElementIndex) const -> UMaterialInterface *
+{
+    return ElementIndex == 0 ? TextMaterialInstance : nullptr;
+}
+
+auto UEditorActorTagDisplayBatchComponent::GetUsedMaterials(TArray<UMaterialInterface *> &OutMaterials,
+                                                            bool /*bGetDebugMaterials*/) const -> void
+{
+    if (TextMaterialInstance != nullptr)
+    {
+        OutMaterials.Add(TextMaterialInstance);
+    }
+}
+
+auto UEditorActorTagDisplayBatchComponent::SendRenderDynamicData_Concurrent() -> void
+{
+    Super::SendRenderDynamicData_Concurrent();
+
+    if (SceneProxy == nullptr)
+    {
+        return;
+    }
+
+    // 1フレーム中の変更はまとめて1回のレンダーコマンドで送る
+    auto *const BatchSceneProxy = static_cast<FEditorActorTagDisplayBatchSceneProxy *>(SceneProxy);
+    ENQUEUE_RENDER_COMMAND(UpdateEditorActorTagDisplayLabels)
+    ([BatchSceneProxy, RenderLabels = GatherRenderLabels(), GlyphScale = GetGlyphScale(),
+      Rotation = FacingRotation](FRHICommandListImmediate &RHICmdList) -> void
+     { BatchSceneProxy->SetLabels_RenderThread(RHICmdList, RenderLabels, GlyphScale, Rotation); });
+}
+
+auto UEditorActorTagDisplayBatchComponent::BuildGlyphs(const FString &Text,
+                                                       TArray<FEditorActorTagDisplayGlyphQuad> &OutGlyphs) const -> void
+{
+    OutGlyphs.Reset();
+
+    // 対応していないフォントの場合、モジュールはPer-Actor描画方式に切り替える
+    if (!UEditorActorTagDisplayBatchComponent::SupportsFont(Font))
+    {
+        return;
+    }
+
+    const UTexture2D *FontTexture = Font->Textures[0];
+    const auto TextureWidth = static_cast<float>(FontTexture->GetSizeX());
+    const auto TextureHeight = static_cast<float>(FontTexture->GetSizeY());
+    const auto LineHeight = static_cast<float>(Font->GetMaxCharHeight());
+    if (TextureWidth <= 0.0F || TextureHeight <= 0.0F)
+    {
+        return;
+    }
+
+    TArray<FString> Lines;
+    Text.ParseIntoArray(Lines, TEXT("\n"), false);
+
+    for (int32 LineIndex = 0; LineIndex < Lines.Num(); ++LineIndex)
+    {
+        const FString &Line = Lines[LineIndex];
+
+        float LineWidth = 0.0F;
+        for (const TCHAR Character : Line)
+        {
+            const int32 CharacterIndex = Font->RemapChar(Character);
+            if (Font->Characters.IsValidIndex(CharacterIndex))
+            {
+                LineWidth += static_cast<float>(Font->Characters[CharacterIndex].USize);
+            }
+        }
+
+        // 水平方向は中央揃え、垂直方向は最終行の下端をアンカーに合わせる
+        float PenX = -LineWidth * 0.5F;
+        const auto LineTop = static_cast<float>(Lines.Num() - LineIndex) * LineHeight;
+
+        for (const TCHAR Character : Line)
+        {
+            const int32 CharacterIndex = Font->RemapChar(Character);
+            if (!Font->Characters.IsValidIndex(CharacterIndex))
+            {
+                continue;
+            }
+
+            const FFontCharacter &FontCharacter = Font->Characters[CharacterIndex];
+            const auto USize = static_cast<float>(FontCharacter.USize);
+            const auto VSize = static_cast<float>(FontCharacter.VSize);
+
+            if (USize > 0.0F && VSize > 0.0F)
+            {
+                const float GlyphTop = LineTop - static_cast<float>(FontCharacter.VerticalOffset);
+
+                FEditorActorTagDisplayGlyphQuad &Glyph = OutGlyphs.AddDefaulted_GetRef();
+                Glyph.OffsetMin = FVector2f(PenX, GlyphTop - VSize);
+                Glyph.OffsetMax = FVector2f(PenX + USize, GlyphTop);
+                Glyph.UVMin = FVector2f(static_cast<float>(FontCharacter.StartU) / TextureWidth,
+                                        static_cast<float>(FontCharacter.StartV) / TextureHeight);
+                Glyph.UVMax = FVector2f((static_cast<float>(FontCharacter.StartU) + USize) / TextureWidth,
+                                        (static_cast<float>(FontCharacter.StartV) + VSize) / TextureHeight);
+            }
+
+            PenX += USize;
+        }
+    }
+}
+
+auto UEditorActorTagDisplayBatchComponent::GetGlyphScale() const -> float
+{
+    if (Font == nullptr)
+    {
+        return 1.0F;
+    }
+
+    const auto LineHeight = static_cast<float>(Font->GetMaxCharHeight());
+    return LineHeight > 0.0F ? TextSize / LineHeight : 1.0F;
+}
+
+auto UEditorActorTagDisplayBatchComponent::GatherRenderLabels() const -> TArray<FEditorActorTagDisplayBatchLabel>
+{
+    TArray<FEditorActorTagDisplayBatchLabel> RenderLabels;
+    RenderLabels.Reserve(Labels.Num());
+    for (const FEditorActorTagDisplayBatchLabel &Label : Labels)
+    {
+        // グリフ配置は共有ポインタのみをコピーし、配列の複製は行わない
+        if (Label.Glyphs.IsValid() && !Label.Glyphs->IsEmpty())
+        {
+            RenderLabels.Add(Label);
+        }
+    }
+    return RenderLabels;
+}
@@ -0,0 +1,242 @@
+#include "EditorActorTagDisplayBenchmarkCommandlet.h"
+#include "EditorActorTagDisplayModule.h"
+#include "EditorActorTagDisplaySettings.h"
+#include "EditorActorTagDisplayLog.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/TargetPoint.h"
+#include "Engine/PointLight.h"
+#include "Engine/SpotLight.h"
+#include "Engine/TriggerBox.h"
+#include "Engine/TriggerSphere.h"
+#include "Engine/DecalActor.h"
+#include "Camera/CameraActor.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/ScopeExit.h"
+#include "UObject/UObjectArray.h"
+
+namespace
+{
+/** Engine actor classes used as distinct class configs. */
+auto GetBenchmarkActorClasses() -> TArray<UClass *>
+{
+    return {AStaticMeshActor::StaticClass(), ATargetPoint::StaticClass(), APointLight::StaticClass(),
+            ASpotLight::StaticClass(),       ATriggerBox::StaticClass(),  ATriggerSphere::StaticClass(),
+            ADecalActor::StaticClass(),      ACameraActor::StaticClass()};
+}
+
+auto ParseActorCounts(const FString &Params) -> TArray<int32>
+{
+    FString ActorsParam = TEXT("1000,10000,100000");
+    FParse::Value(*Params, TEXT("Actors="), ActorsParam, false);
+
+    TArray<FString> Tokens;
+    ActorsParam.ParseIntoArray(Tokens, TEXT(","));
+
+    TArray<int32> ActorCounts;
+    for (const FString &Token : Tokens)
+    {
+        const int32 Count = FCString::Atoi(*Token);
+        if (Count > 0)
+        {
+            ActorCounts.Add(Count);
+        }
+    }
+    return ActorCounts;
+}
+
+auto ComputePercentile(const TArray<double> &SortedSamples, double Percentile) -> double
+{
+    if (SortedSamples.IsEmpty())
+    {
+        return 0.0;
+    }
+
+    const int32 Index = FMath::Clamp(FMath::CeilToInt32(Percentile * SortedSamples.Num()) - 1, 0,
+                                     SortedSamples.Num() - 1);
+    return SortedSamples[Index];
+}
+} // namespace
+
+UEditorActorTagDisplayBenchmarkCommandlet::UEditorActorTagDisplayBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+auto UEditorActorTagDisplayBenchmarkCommandlet::Main(const FString &Params) -> int32
+{
+    const TArray<int32> ActorCounts = ParseActorCounts(Params);
+    int32 NumConfigs = DefaultNumConfigs;
+    int32 NumTicks = DefaultNumTicks;
+    FParse::Value(*Params, TEXT("Configs="), NumConfigs);
+    FParse::Value(*Params, TEXT("Ticks="), NumTicks);
+
+    FString OutputPath = FPaths::ProjectSavedDir() / TEXT("EditorActorTagDisplay") / TEXT("Benchmark.json");
+    FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+    const TSharedPtr<FJsonObject> Report =
+        UEditorActorTagDisplayBenchmarkCommandlet::RunBenchmark(ActorCounts, NumConfigs, NumTicks);
+    if (!Report.IsValid())
+    {
+        return 1;
+    }
+
+    FString Json;
+    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+    FJsonSerializer::Serialize(Report.ToSharedRef(), Writer);
+
+    if (!FFileHelper::SaveStringToFile(Json, *OutputPath))
+    {
+        // NOLINTNEXTLINE
+        UE_LOG(LogEditorActorTagDisplay, Error, TEXT("Failed to write benchmark results to %s"), *OutputPath);
+        return 1;
+    }
+
+    // NOLINTNEXTLINE
+    UE_LOG(LogEditorActorTagDisplay, Display, TEXT("Benchmark results written to %s\n%s"), *OutputPath, *Json);
+    return 0;
+}
+
+auto UEditorActorTagDisplayBenchmarkCommandlet::RunBenchmark(TConstArrayView<int32> ActorCounts, int32 NumConfigs,
+                                                             int32 NumTicks) -> TSharedPtr<FJsonObject>
+{
+    UEditorActorTagDisplaySettings *Settings = UEditorActorTagDisplaySettings::Get();
+    if (Settings == nullptr || GEngine == nullptr)
+    {
+        // NOLINTNEXTLINE
+        UE_LOG(LogEditorActorTagDisplay, Error, TEXT("Benchmark requires the engine and plugin settings."));
+        return nullptr;
+    }
+
+    NumConfigs = FMath::Clamp(NumConfigs, 1, GetBenchmarkActorClasses().Num());
+    NumTicks = FMath::Max(NumTicks, 1);
+
+    // ベンチマーク用にクラス設定をメモリ上でのみ差し替え、途中で終了してもユーザーのiniを書き換えないようにする
+    const TArray<FActorClassTagDisplayConfig> SavedClassConfigs = Settings->GetClassConfigs();
+    const bool bWasTagDisplayEnabled = Settings->IsTagDisplayEnabled();
+    ON_SCOPE_EXIT
+    {
+        Settings->SetClassConfigs(SavedClassConfigs, false);
+        Settings->SetTagDisplayEnabled(bWasTagDisplayEnabled, false);
+    };
+
+    const TArray<UClass *> ActorClasses = GetBenchmarkActorClasses();
+    TArray<FActorClassTagDisplayConfig> BenchmarkConfigs;
+    for (int32 Index = 0; Index < NumConfigs; ++Index)
+    {
+        FActorClassTagDisplayConfig &Config = BenchmarkConfigs.AddDefaulted_GetRef();
+        Config.ActorClass = ActorClasses[Index];
+        Config.DisplayColor = FLinearColor::MakeFromHSV8(static_cast<uint8>(Index * 32), 255, 255);
+    }
+    Settings->SetClassConfigs(BenchmarkConfigs, false);
+    Settings->SetTagDisplayEnabled(true, false);
+
+    // エディターのティックがないため、マテリアルの非同期読み込みはここで待つ
+    FModuleManager::LoadModuleChecked<FEditorActorTagDisplayModule>(TEXT("EditorActorTagDisplay"))
+        .WaitForTextMaterials();
+
+    const TSharedPtr<FJsonObject> Report = MakeShared<FJsonObject>();
+    Report->SetStringField(TEXT("Platform"), FPlatformProperties::IniPlatformName());
+    Report->SetStringField(TEXT("RenderMode"),
+                           StaticEnum<EEditorActorTagDisplayRenderMode>()->GetNameStringByValue(
+                               static_cast<int64>(Settings->GetRenderMode())));
+    Report->SetBoolField(TEXT("IncrementalUpdate"), Settings->IsIncrementalUpdateEnabled());
+    Report->SetNumberField(TEXT("UpdateBudgetMs"), Settings->GetUpdateBudgetMs());
+    Report->SetNumberField(TEXT("NumConfigs"), NumConfigs);
+    Report->SetNumberField(TEXT("NumTicks"), NumTicks);
+
+    TArray<TSharedPtr<FJsonValue>> Scenarios;
+    for (const int32 NumActors : ActorCounts)
+    {
+        // NOLINTNEXTLINE
+        UE_LOG(LogEditorActorTagDisplay, Display, TEXT("Benchmarking %d actors across %d class configs..."), NumActors,
+               NumConfigs);
+        Scenarios.Add(MakeShared<FJsonValueObject>(
+            UEditorActorTagDisplayBenchmarkCommandlet::RunScenario(NumActors, NumConfigs, NumTicks)));
+    }
+    Report->SetArrayField(TEXT("Scenarios"), Scenarios);
+    return Report;
+}
+
+auto UEditorActorTagDisplayBenchmarkCommandlet::RunScenario(int32 NumActors, int32 NumConfigs, int32 NumTicks)
+    -> TSharedPtr<FJsonObject>
+{
+    auto &Module = FModuleManager::LoadModuleChecked<FEditorActorTagDisplayModule>(TEXT("EditorActorTagDisplay"));
+
+    // 描画されない一時的なエディターワールドを作成する
+    FWorldContext &WorldContext = GEngine->CreateNewWorldContext(EWorldType::Editor);
+    UWorld *World = UWorld::CreateWorld(EWorldType::Editor, false, TEXT("EditorActorTagDisplayBenchmark"));
+    WorldContext.SetCurrentWorld(World);
+
+    const TArray<UClass *> ActorClasses = GetBenchmarkActorClasses();
+    const int32 GridSize = FMath::Max(FMath::CeilToInt32(FMath::Sqrt(static_cast<double>(NumActors))), 1);
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    SpawnParams.ObjectFlags = RF_Transient;
+
+    for (int32 Index = 0; Index < NumActors; ++Index)
+    {
+        const FVector Location((Index % GridSize) * ActorSpacing, (Index / GridSize) * ActorSpacing, 0.0);
+        AActor *Actor = World->SpawnActor(ActorClasses[Index % NumConfigs], &Location, nullptr, SpawnParams);
+        if (Actor != nullptr)
+        {
+            Actor->Tags.Add(FName(TEXT("Benchmark"), Index % NumDistinctTags));
+            Actor->Tags.Add(FName(TEXT("Group"), Index % (NumDistinctTags / 2)));
+        }
+    }
+
+    const int32 NumObjectsBefore = GUObjectArray.GetObjectArrayNumMinusAvailable();
+    const uint64 UsedMemoryBefore = FPlatformMemory::GetStats().UsedPhysical;
+
+    Module.SetWorldOverride(World);
+
+    TArray<double> TickTimesMs;
+    TickTimesMs.Reserve(NumTicks);
+    for (int32 Tick = 0; Tick < NumTicks; ++Tick)
+    {
+        const uint64 StartCycles = FPlatformTime::Cycles64();
+        Module.UpdateTextActors();
+        TickTimesMs.Add(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
+    }
+
+    const int32 NumLabels = Module.GetNumLabels();
+    const int32 NumObjectsAfter = GUObjectArray.GetObjectArrayNumMinusAvailable();
+    const uint64 UsedMemoryAfter = FPlatformMemory::GetStats().UsedPhysical;
+
+    Module.SetWorldOverride(nullptr);
+
+    GEngine->DestroyWorldContext(World);
+    World->DestroyWorld(false);
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+    // 最初のティックはワールド全体の走査を含むため、平均とは別に記録する
+    const double FirstTickMs = TickTimesMs[0];
+    double TotalMs = 0.0;
+    for (const double TickMs : TickTimesMs)
+    {
+        TotalMs += TickMs;
+    }
+    TickTimesMs.Sort();
+
+    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetNumberField(TEXT("NumActors"), NumActors);
+    Result->SetNumberField(TEXT("NumLabels"), NumLabels);
+    Result->SetNumberField(TEXT("FirstTickMs"), FirstTickMs);
+    Result->SetNumberField(TEXT("MeanTickMs"), TotalMs / TickTimesMs.Num());
+    Result->SetNumberField(TEXT("P99TickMs"), ComputePercentile(TickTimesMs, 0.99));
+    Result->SetNumberField(TEXT("MaxTickMs"), TickTimesMs.Last());
+    Result->SetNumberField(TEXT("UObjectsAllocated"), NumObjectsAfter - NumObjectsBefore);
+    Result->SetNumberField(TEXT("UsedPhysicalDeltaBytes"),
+                           static_cast<double>(static_cast<int64>(UsedMemoryAfter - UsedMemoryBefore)));
+    return Result;
+}
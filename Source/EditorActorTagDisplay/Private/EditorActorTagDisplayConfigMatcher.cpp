@@ -0,0 +1,104 @@
+#include "EditorActorTagDisplayConfigMatcher.h"
+#include "EditorActorTagDisplaySettings.h"
+#include "GameFramework/Actor.h"
+
+auto FEditorActorTagDisplayConfigMatcher::FindConfigIndex(const UClass *ActorClass,
+                                                          const TArray<FActorClassTagDisplayConfig> &ClassConfigs)
+    -> int32
+{
+    // NOLINTNEXTLINE
+    check(ActorClass != nullptr);
+
+    const TObjectKey<UClass> ClassKey(ActorClass);
+    if (const int32 *CachedIndex = ClassConfigIndexCache.Find(ClassKey))
+    {
+        return *CachedIndex;
+    }
+
+    // 先頭から最初に一致した設定を採用する（一致なしもキャッシュする）
+    int32 MatchedIndex = INDEX_NONE;
+    for (int32 Index = 0; Index < ClassConfigs.Num(); ++Index)
+    {
+        const UClass *ConfigClass = ClassConfigs[Index].ActorClass.Get();
+        if (ConfigClass != nullptr && ActorClass->IsChildOf(ConfigClass))
+        {
+            MatchedIndex = Index;
+            break;
+        }
+    }
+
+    ClassConfigIndexCache.Add(ClassKey, MatchedIndex);
+    return MatchedIndex;
+}
+
+auto FEditorActorTagDisplayConfigMatcher::GetTagFilter(int32 ConfigIndex,
+                                                       const TArray<FActorClassTagDisplayConfig> &ClassConfigs)
+    -> FEditorActorTagDisplayTagFilter &
+{
+    // フィルターは設定の変更時に破棄され、次に必要になった時にまとめてコンパイルする
+    if (TagFilters.Num() != ClassConfigs.Num())
+    {
+        TagFilters.Reset(ClassConfigs.Num());
+        for (const FActorClassTagDisplayConfig &Config : ClassConfigs)
+        {
+            TagFilters.Emplace(Config.IncludeTagPatterns, Config.ExcludeTagPatterns);
+        }
+    }
+
+    // NOLINTNEXTLINE
+    check(TagFilters.IsValidIndex(ConfigIndex));
+    return TagFilters[ConfigIndex];
+}
+
+auto FEditorActorTagDisplayConfigMatcher::MatchActor(const AActor *Actor,
+                                                     const TArray<FActorClassTagDisplayConfig> &ClassConfigs) -> int32
+{
+    // NOLINTNEXTLINE
+    check(Actor != nullptr);
+
+    // クラスが一致しても、表示する内容が1つもなければラベルを出さない
+    const int32 ConfigIndex = FindConfigIndex(Actor->GetClass(), ClassConfigs);
+    if (ConfigIndex == INDEX_NONE ||
+        !LabelSources.HasContent(Actor, ClassConfigs[ConfigIndex], GetTagFilter(ConfigIndex, ClassConfigs)))
+    {
+        return INDEX_NONE;
+    }
+    return ConfigIndex;
+}
+
+auto FEditorActorTagDisplayConfigMatcher::MayShowLabel(const AActor *Actor,
+                                                       const TArray<FActorClassTagDisplayConfig> &ClassConfigs) -> bool
+{
+    // NOLINTNEXTLINE
+    check(Actor != nullptr);
+
+    // タグ以外を表示する設定のアクターは、タグがなくても候補にする
+    const int32 ConfigIndex = FindConfigIndex(Actor->GetClass(), ClassConfigs);
+    return ConfigIndex != INDEX_NONE &&
+           (!Actor->Tags.IsEmpty() || FEditorActorTagDisplayLabelSources::HasExtraSources(ClassConfigs[ConfigIndex]));
+}
+
+auto FEditorActorTagDisplayConfigMatcher::AppendLabelContent(const AActor *Actor, int32 ConfigIndex,
+                                                             const TArray<FActorClassTagDisplayConfig> &ClassConfigs,
+                                                             TArray<FName> &OutTags, FString &OutValueText) -> int32
+{
+    return LabelSources.AppendContent(Actor, ClassConfigs[ConfigIndex], GetTagFilter(ConfigIndex, ClassConfigs),
+                                      OutTags, OutValueText);
+}
+
+auto FEditorActorTagDisplayConfigMatcher::InvalidateValueText(const AActor *Actor) -> void
+{
+    LabelSources.InvalidateValueText(Actor);
+}
+
+auto FEditorActorTagDisplayConfigMatcher::InvalidateAllValueTexts() -> void
+{
+    LabelSources.InvalidateAllValueTexts();
+}
+
+auto FEditorActorTagDisplayConfigMatcher::Reset() -> void
+{
+    ClassConfigIndexCache.Reset();
+    TagFilters.Reset();
+    LabelSources.Reset();
+}
@@ -0,0 +1,167 @@
+#include "EditorActorTagDisplayLabelSnapshot.h"
+#include "EditorActorTagDisplayConfigMatcher.h"
+#include "Async/ParallelFor.h"
+#include "GameFramework/Actor.h"
+#include "EditorActorTagDisplayStats.h"
+
+auto FEditorActorTagDisplayLabelSnapshot::Add(AActor *Actor, int32 ConfigIndex,
+                                              FEditorActorTagDisplayConfigMatcher &ConfigMatcher,
+                                              const TArray<FActorClassTagDisplayConfig> &ClassConfigs,
+                                              const FVector &AnchorPosition, const FVector &PositionOffset,
+                                              uint32 KnownTagsHash, bool bHasKnownTagsHash) -> int32
+{
+    // NOLINTNEXTLINE
+    check(Actor != nullptr);
+
+    const int32 Index = Actors.Add(Actor);
+    ConfigIndices.Add(ConfigIndex);
+    AnchorPositions.Add(AnchorPosition);
+    PositionOffsets.Add(PositionOffset);
+    KnownTagsHashes.Add(KnownTagsHash);
+    HasKnownTagsHash.Add(bHasKnownTagsHash);
+
+    // 表示するタグのみFNameのままコピーし、文字列化はワーカースレッドで行う
+    // プロパティの値はUObjectを読む必要があるため、ここで文字列化しておく
+    TagStarts.Add(TagNames.Num());
+    ValueTextStarts.Add(ValueTexts.Len());
+    const int32 NumTagsBefore = TagNames.Num();
+    ValueLineCounts.Add(ConfigMatcher.AppendLabelContent(Actor, ConfigIndex, ClassConfigs, TagNames, ValueTexts));
+    TagCounts.Add(TagNames.Num() - NumTagsBefore);
+    ValueTextLengths.Add(ValueTexts.Len() - ValueTextStarts.Last());
+
+    return Index;
+}
+
+auto FEditorActorTagDisplayLabelSnapshot::Reset() -> void
+{
+    Actors.Reset();
+    ConfigIndices.Reset();
+    AnchorPositions.Reset();
+    PositionOffsets.Reset();
+    KnownTagsHashes.Reset();
+    HasKnownTagsHash.Reset();
+    TagNames.Reset();
+    TagStarts.Reset();
+    TagCounts.Reset();
+    ValueTexts.Reset();
+    ValueTextStarts.Reset();
+    ValueTextLengths.Reset();
+    ValueLineCounts.Reset();
+    TagsHashes.Reset();
+    Texts.Reset();
+    HasText.Reset();
+    TextPositions.Reset();
+    TextRotations.Reset();
+}
+
+auto FEditorActorTagDisplayLabelSnapshot::Build(const FVector &CameraLocation) -> void
+{
+    SCOPE_CYCLE_COUNTER(STAT_EditorActorTagDisplay_BuildSnapshot);
+    TRACE_CPUPROFILER_EVENT_SCOPE(EditorActorTagDisplay::BuildLabelSnapshot);
+
+    const int32 NumLabels = Actors.Num();
+    TagsHashes.SetNumUninitialized(NumLabels);
+    Texts.SetNum(NumLabels);
+    HasText.SetNumUninitialized(NumLabels);
+    TextPositions.SetNumUninitialized(NumLabels);
+    TextRotations.SetNumUninitialized(NumLabels);
+
+    // 各要素は自分のインデックスにのみ書き込むため、ワーカー間の同期は不要
+    ParallelFor(
+        TEXT("EditorActorTagDisplay.BuildLabels"), NumLabels, MinParallelBatchSize,
+        [this, &CameraLocation](int32 Index) -> void
+        {
+            const uint32 TagsHash = HashContent(Index);
+            TagsHashes[Index] = TagsHash;
+
+            const bool bNeedsText = !HasKnownTagsHash[Index] || KnownTagsHashes[Index] != TagsHash;
+            Texts[Index].Reset();
+            if (bNeedsText)
+            {
+                BuildText(Index, Texts[Index]);
+            }
+            HasText[Index] = bNeedsText;
+
+            const FVector TextPosition = AnchorPositions[Index] + PositionOffsets[Index];
+            TextPositions[Index] = TextPosition;
+            TextRotations[Index] =
+                FEditorActorTagDisplayLabelSnapshot::ComputeLookAtRotation(TextPosition, CameraLocation);
+        });
+}
+
+auto FEditorActorTagDisplayLabelSnapshot::EnsureText(int32 Index) -> const FString &
+{
+    if (!HasText[Index])
+    {
+        Texts[Index].Reset();
+        BuildText(Index, Texts[Index]);
+        HasText[Index] = true;
+    }
+    return Texts[Index];
+}
+
+auto FEditorActorTagDisplayLabelSnapshot::ComputeLookAtRotation(const FVector &TextPosition,
+                                                                const FVector &CameraLocation) -> FRotator
+{
+    return (CameraLocation - TextPosition).GetSafeNormal().Rotation();
+}
+
+auto FEditorActorTagDisplayLabelSnapshot::HashTags(TConstArrayView<FName> Tags) -> uint32
+{
+    // 大文字小文字の変更も検出できるよう、比較用ではなく表示用のインデックスをハッシュする
+    uint32 Hash = GetTypeHash(Tags.Num());
+    for (const FName &Tag : Tags)
+    {
+        Hash = HashCombineFast(Hash, GetTypeHash(Tag.GetDisplayIndex()));
+        Hash = HashCombineFast(Hash, GetTypeHash(Tag.GetNumber()));
+    }
+    return Hash;
+}
+
+auto FEditorActorTagDisplayLabelSnapshot::AppendTagsText(TConstArrayView<FName> Tags, FString &OutText) -> void
+{
+    // 一時的なFString配列を作らず、FNameから直接書き込む
+    for (int32 Index = 0; Index < Tags.Num(); ++Index)
+    {
+        if (Index > 0)
+        {
+            OutText.AppendChar(TEXT('\n'));
+        }
+        Tags[Index].AppendString(OutText);
+    }
+}
+
+auto FEditorActorTagDisplayLabelSnapshot::GetTags(int32 Index) const -> TConstArrayView<FName>
+{
+    return TConstArrayView<FName>(TagNames.GetData() + TagStarts[Index], TagCounts[Index]);
+}
+
+auto FEditorActorTagDisplayLabelSnapshot::GetValueText(int32 Index) const -> FStringView
+{
+    return FStringView(*ValueTexts + ValueTextStarts[Index], ValueTextLengths[Index]);
+}
+
+auto FEditorActorTagDisplayLabelSnapshot::HashContent(int32 Index) const -> uint32
+{
+    const uint32 TagsHash = FEditorActorTagDisplayLabelSnapshot::HashTags(GetTags(Index));
+    if (ValueLineCounts[Index] == 0)
+    {
+        return TagsHash;
+    }
+
+    const FStringView ValueText = GetValueText(Index);
+    return HashCombineFast(TagsHash, FCrc::MemCrc32(ValueText.GetData(), ValueText.Len() * sizeof(TCHAR)));
+}
+
+auto FEditorActorTagDisplayLabelSnapshot::BuildText(int32 Index, FString &OutText) const -> void
+{
+    FEditorActorTagDisplayLabelSnapshot::AppendTagsText(GetTags(Index), OutText);
+    if (ValueLineCounts[Index] > 0)
+    {
+        if (TagCounts[Index] > 0)
+        {
+            OutText.AppendChar(TEXT('\n'));
+        }
+        OutText.Append(GetValueText(Index));
+    }
+}
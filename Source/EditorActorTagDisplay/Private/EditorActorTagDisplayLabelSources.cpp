@@ -0,0 +1,360 @@
+#include "EditorActorTagDisplayLabelSources.h"
+#include "EditorActorTagDisplaySettings.h"
+#include "EditorActorTagDisplayTagFilter.h"
+#include "EditorActorTagDisplayLog.h"
+#include "Components/ActorComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameplayTagContainer.h"
+#include "UObject/UnrealType.h"
+
+auto FEditorActorTagDisplayLabelSources::HasExtraSources(const FActorClassTagDisplayConfig &Config) -> bool
+{
+    for (const FEditorActorTagDisplayLabelSource &Source : Config.LabelSources)
+    {
+        if (Source.SourceType != EEditorActorTagDisplayLabelSourceType::ActorTags)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+auto FEditorActorTagDisplayLabelSources::HasContent(const AActor *Actor, const FActorClassTagDisplayConfig &Config,
+                                                    FEditorActorTagDisplayTagFilter &TagFilter) -> bool
+{
+    // NOLINTNEXTLINE
+    check(Actor != nullptr);
+
+    // 取得元を指定していない設定はアクターのタグのみを表示する
+    if (Config.LabelSources.IsEmpty())
+    {
+        return TagFilter.PassesAny(Actor->Tags);
+    }
+
+    // タグは文字列化より安いため先に調べる
+    const TConstArrayView<FResolvedSource> Sources = Resolve(Actor->GetClass(), Config);
+    bool bHasValueSources = false;
+    for (const FResolvedSource &Source : Sources)
+    {
+        if (Source.Kind == EContentKind::ValueText)
+        {
+            bHasValueSources = true;
+            continue;
+        }
+
+        ScratchTags.Reset();
+        if (FEditorActorTagDisplayLabelSources::AppendSourceTags(Actor, Source, TagFilter, ScratchTags) > 0)
+        {
+            return true;
+        }
+    }
+    return bHasValueSources && GetValueText(Actor, Sources).NumLines > 0;
+}
+
+auto FEditorActorTagDisplayLabelSources::AppendContent(const AActor *Actor, const FActorClassTagDisplayConfig &Config,
+                                                       FEditorActorTagDisplayTagFilter &TagFilter,
+                                                       TArray<FName> &OutTags, FString &OutValueText) -> int32
+{
+    // NOLINTNEXTLINE
+    check(Actor != nullptr);
+
+    if (Config.LabelSources.IsEmpty())
+    {
+        TagFilter.AppendPassingTags(Actor->Tags, OutTags);
+        return 0;
+    }
+
+    const TConstArrayView<FResolvedSource> Sources = Resolve(Actor->GetClass(), Config);
+    bool bHasValueSources = false;
+    for (const FResolvedSource &Source : Sources)
+    {
+        if (Source.Kind == EContentKind::ValueText)
+        {
+            bHasValueSources = true;
+            continue;
+        }
+        FEditorActorTagDisplayLabelSources::AppendSourceTags(Actor, Source, TagFilter, OutTags);
+    }
+    if (!bHasValueSources)
+    {
+        return 0;
+    }
+
+    const FValueText &Value = GetValueText(Actor, Sources);
+    OutValueText += Value.Text;
+    return Value.NumLines;
+}
+
+auto FEditorActorTagDisplayLabelSources::InvalidateValueText(const AActor *Actor) -> void
+{
+    ValueTextByActor.Remove(Actor);
+}
+
+auto FEditorActorTagDisplayLabelSources::InvalidateAllValueTexts() -> void
+{
+    ValueTextByActor.Reset();
+}
+
+auto FEditorActorTagDisplayLabelSources::Reset() -> void
+{
+    SourcesByClass.Reset();
+    ValueTextByActor.Reset();
+}
+
+auto FEditorActorTagDisplayLabelSources::Resolve(const UClass *ActorClass, const FActorClassTagDisplayConfig &Config)
+    -> TConstArrayView<FResolvedSource>
+{
+    // NOLINTNEXTLINE
+    check(ActorClass != nullptr);
+
+    const TObjectKey<UClass> ClassKey(ActorClass);
+    if (const TArray<FResolvedSource> *CachedSources = SourcesByClass.Find(ClassKey))
+    {
+        return *CachedSources;
+    }
+
+    TArray<FResolvedSource> &Sources = SourcesByClass.Add(ClassKey);
+    Sources.Reserve(Config.LabelSources.Num());
+    for (const FEditorActorTagDisplayLabelSource &Source : Config.LabelSources)
+    {
+        Sources.Add(FEditorActorTagDisplayLabelSources::ResolveSource(ActorClass, Source));
+    }
+    return Sources;
+}
+
+auto FEditorActorTagDisplayLabelSources::ResolveSource(const UClass *ActorClass,
+                                                       const FEditorActorTagDisplayLabelSource &Source)
+    -> FResolvedSource
+{
+    FResolvedSource Resolved;
+    if (Source.SourceType == EEditorActorTagDisplayLabelSourceType::ActorTags)
+    {
+        Resolved.Kind = EContentKind::ActorTags;
+        return Resolved;
+    }
+    if (Source.SourceType == EEditorActorTagDisplayLabelSourceType::ComponentTags)
+    {
+        Resolved.Kind = EContentKind::ComponentTags;
+        return Resolved;
+    }
+
+    TArray<FString> Segments;
+    Source.PropertyPath.ParseIntoArray(Segments, TEXT("."));
+
+    // 途中の要素は構造体かオブジェクト参照のみたどれる（オブジェクトは宣言された型で次の要素を探す）
+    const UStruct *Owner = ActorClass;
+    for (int32 Index = 0; Index < Segments.Num(); ++Index)
+    {
+        const FProperty *Property = Owner != nullptr ? FindFProperty<FProperty>(Owner, *Segments[Index]) : nullptr;
+        if (Property == nullptr)
+        {
+            // NOLINTNEXTLINE
+            UE_LOG(LogEditorActorTagDisplay, Warning, TEXT("Label source '%s' cannot be resolved on %s."),
+                   *Source.PropertyPath, *ActorClass->GetName());
+            Resolved.Chain.Reset();
+            return Resolved;
+        }
+
+        FChainLink &Link = Resolved.Chain.AddDefaulted_GetRef();
+        Link.Property = Property;
+        Owner = nullptr;
+        if (Index + 1 < Segments.Num())
+        {
+            if (const FObjectProperty *ObjectProperty = CastField<FObjectProperty>(Property))
+            {
+                Link.Object = ObjectProperty;
+                Owner = ObjectProperty->PropertyClass;
+            }
+            else if (const FStructProperty *StructProperty = CastField<FStructProperty>(Property))
+            {
+                Owner = StructProperty->Struct;
+            }
+        }
+    }
+
+    if (Resolved.Chain.IsEmpty())
+    {
+        return Resolved;
+    }
+
+    // 末端の型で表示方法を決める
+    const FProperty *ValueProperty = Resolved.Chain.Last().Property;
+    if (const FStructProperty *StructProperty = CastField<FStructProperty>(ValueProperty))
+    {
+        if (StructProperty->Struct == FGameplayTagContainer::StaticStruct())
+        {
+            Resolved.Kind = EContentKind::GameplayTagContainer;
+            return Resolved;
+        }
+        if (StructProperty->Struct == FGameplayTag::StaticStruct())
+        {
+            Resolved.Kind = EContentKind::GameplayTag;
+            return Resolved;
+        }
+    }
+    if (const FArrayProperty *ArrayProperty = CastField<FArrayProperty>(ValueProperty))
+    {
+        if (ArrayProperty->Inner->IsA<FNameProperty>())
+        {
+            Resolved.Kind = EContentKind::NameArray;
+            return Resolved;
+        }
+    }
+
+    Resolved.Kind = EContentKind::ValueText;
+    Resolved.Caption = Source.PropertyPath + TEXT(": ");
+    return Resolved;
+}
+
+auto FEditorActorTagDisplayLabelSources::ReadValue(const AActor *Actor, const FResolvedSource &Source) -> const void *
+{
+    const void *Container = Actor;
+    const void *Value = nullptr;
+    for (int32 Index = 0; Index < Source.Chain.Num(); ++Index)
+    {
+        const FChainLink &Link = Source.Chain[Index];
+        Value = Link.Property->ContainerPtrToValuePtr<void>(Container);
+        if (Index + 1 == Source.Chain.Num())
+        {
+            break;
+        }
+
+        if (Link.Object != nullptr)
+        {
+            const UObject *Object = Link.Object->GetObjectPropertyValue(Value);
+            if (!IsValid(Object))
+            {
+                return nullptr;
+            }
+            Container = Object;
+        }
+        else
+        {
+            Container = Value;
+        }
+    }
+    return Value;
+}
+
+auto FEditorActorTagDisplayLabelSources::GetValueText(const AActor *Actor, TConstArrayView<FResolvedSource> Sources)
+    -> const FValueText &
+{
+    // ゲームワールドの値は変更通知なしに変わるため、毎回文字列化する
+    const UWorld *World = Actor->GetWorld();
+    if (World != nullptr && World->IsGameWorld())
+    {
+        FEditorActorTagDisplayLabelSources::FormatValueText(Actor, Sources, ScratchValueText);
+        return ScratchValueText;
+    }
+
+    if (const FValueText *CachedValue = ValueTextByActor.Find(Actor))
+    {
+        return *CachedValue;
+    }
+    FValueText &Value = ValueTextByActor.Add(Actor);
+    FEditorActorTagDisplayLabelSources::FormatValueText(Actor, Sources, Value);
+    return Value;
+}
+
+auto FEditorActorTagDisplayLabelSources::FormatValueText(const AActor *Actor, TConstArrayView<FResolvedSource> Sources,
+                                                         FValueText &OutValue) -> void
+{
+    OutValue.Text.Reset();
+    OutValue.NumLines = 0;
+
+    FString ValueString;
+    for (const FResolvedSource &Source : Sources)
+    {
+        if (Source.Kind != EContentKind::ValueText)
+        {
+            continue;
+        }
+        const void *Value = FEditorActorTagDisplayLabelSources::ReadValue(Actor, Source);
+        if (Value == nullptr)
+        {
+            continue;
+        }
+
+        // 空文字列になる値（空の文字列・配列など）は行を出さない
+        ValueString.Reset();
+        Source.Chain.Last().Property->ExportText_Direct(ValueString, Value, Value, nullptr, PPF_None);
+        if (ValueString.IsEmpty())
+        {
+            continue;
+        }
+
+        if (OutValue.NumLines > 0)
+        {
+            OutValue.Text.AppendChar(TEXT('\n'));
+        }
+        OutValue.Text += Source.Caption;
+        OutValue.Text += ValueString;
+        ++OutValue.NumLines;
+    }
+}
+
+auto FEditorActorTagDisplayLabelSources::AppendSourceTags(const AActor *Actor, const FResolvedSource &Source,
+                                                          FEditorActorTagDisplayTagFilter &TagFilter,
+                                                          TArray<FName> &OutTags) -> int32
+{
+    switch (Source.Kind)
+    {
+    case EContentKind::ActorTags:
+        return TagFilter.AppendPassingTags(Actor->Tags, OutTags);
+
+    case EContentKind::ComponentTags:
+    {
+        int32 NumTags = 0;
+        for (const UActorComponent *Component : Actor->GetComponents())
+        {
+            if (Component != nullptr)
+            {
+                NumTags += TagFilter.AppendPassingTags(Component->ComponentTags, OutTags);
+            }
+        }
+        return NumTags;
+    }
+
+    case EContentKind::GameplayTagContainer:
+    {
+        const auto *Container =
+            static_cast<const FGameplayTagContainer *>(FEditorActorTagDisplayLabelSources::ReadValue(Actor, Source));
+        int32 NumTags = 0;
+        if (Container != nullptr)
+        {
+            for (const FGameplayTag &Tag : *Container)
+            {
+                if (TagFilter.PassesTag(Tag.GetTagName()))
+                {
+                    OutTags.Add(Tag.GetTagName());
+                    ++NumTags;
+                }
+            }
+        }
+        return NumTags;
+    }
+
+    case EContentKind::GameplayTag:
+    {
+        const auto *Tag =
+            static_cast<const FGameplayTag *>(FEditorActorTagDisplayLabelSources::ReadValue(Actor, Source));
+        if (Tag == nullptr || !Tag->IsValid() || !TagFilter.PassesTag(Tag->GetTagName()))
+        {
+            return 0;
+        }
+        OutTags.Add(Tag->GetTagName());
+        return 1;
+    }
+
+    case EContentKind::NameArray:
+    {
+        const auto *Names =
+            static_cast<const TArray<FName> *>(FEditorActorTagDisplayLabelSources::ReadValue(Actor, Source));
+        return Names != nullptr ? TagFilter.AppendPassingTags(*Names, OutTags) : 0;
+    }
+
+    default:
+        return 0;
+    }
+}
@@ -0,0 +1,87 @@
+#include "EditorActorTagDisplayLabelTable.h"
+#include "GameFramework/Actor.h"
+
+auto FEditorActorTagDisplayLabelTable::Find(const TWeakObjectPtr<AActor> &Actor) const -> int32
+{
+    const int32 *Handle = SlotByActor.Find(Actor);
+    return Handle != nullptr ? *Handle : INDEX_NONE;
+}
+
+auto FEditorActorTagDisplayLabelTable::FindOrAdd(const TWeakObjectPtr<AActor> &Actor) -> int32
+{
+    if (const int32 *ExistingHandle = SlotByActor.Find(Actor))
+    {
+        return *ExistingHandle;
+    }
+
+    int32 Handle = INDEX_NONE;
+    if (!FreeSlots.IsEmpty())
+    {
+        Handle = FreeSlots.Pop(EAllowShrinking::No);
+    }
+    else
+    {
+        Handle = Actors.AddDefaulted();
+        LastSeenGenerations.AddZeroed();
+        TextHashes.AddZeroed();
+        Anchors.AddZeroed();
+        Entries.AddDefaulted();
+    }
+
+    Actors[Handle] = Actor;
+    LastSeenGenerations[Handle] = Generation;
+    TextHashes[Handle] = 0;
+    Anchors[Handle] = FVector::ZeroVector;
+    Entries[Handle] = FEditorActorTagDisplayLabelEntry();
+
+    SlotByActor.Add(Actor, Handle);
+    ++NumLabels;
+    return Handle;
+}
+
+auto FEditorActorTagDisplayLabelTable::Remove(int32 Handle) -> void
+{
+    // NOLINTNEXTLINE
+    check(IsValidHandle(Handle));
+
+    SlotByActor.Remove(Actors[Handle]);
+    Actors[Handle].Reset();
+    Entries[Handle].TextActor.Reset();
+    LastSeenGenerations[Handle] = FreeGeneration;
+    FreeSlots.Add(Handle);
+    --NumLabels;
+}
+
+auto FEditorActorTagDisplayLabelTable::Reset() -> void
+{
+    Actors.Reset();
+    LastSeenGenerations.Reset();
+    TextHashes.Reset();
+    Anchors.Reset();
+    Entries.Reset();
+    FreeSlots.Reset();
+    SlotByActor.Reset();
+    NumLabels = 0;
+}
+
+auto FEditorActorTagDisplayLabelTable::BeginPass() -> void
+{
+    // 0は空きスロットの印なので、一周した場合は飛ばす
+    ++Generation;
+    if (Generation == FreeGeneration)
+    {
+        ++Generation;
+    }
+}
+
+auto FEditorActorTagDisplayLabelTable::MarkSeen(const TWeakObjectPtr<AActor> &Actor) -> bool
+{
+    const int32 *Handle = SlotByActor.Find(Actor);
+    if (Handle == nullptr)
+    {
+        return false;
+    }
+
+    LastSeenGenerations[*Handle] = Generation;
+    return true;
+}
@@ -1,8 +1,13 @@
 #include "EditorActorTagDisplayModule.h"
 #include "EditorActorTagDisplaySettings.h"
 #include "EditorActorTagDisplayActor.h"
+#include "EditorActorTagDisplayBatchActor.h"
 #include "EditorActorTagDisplayLog.h"
+#include "EditorActorTagDisplayLabelSnapshot.h"
+#include "EditorActorTagDisplayTagFilter.h"
+#include "EditorActorTagDisplayStats.h"
 #include "Engine/World.h"
+#include "Engine/Level.h"
 #include "Serialization/MemoryLayout.h"
 #include "ToolMenus.h"
 #include "Framework/MultiBox/MultiBoxBuilder.h"
@@ -19,14 +24,31 @@
 #include "Materials/MaterialInterface.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Engine/AssetManager.h"
+#include "ConvexVolume.h"
+#include "Kismet/GameplayStatics.h"
+#include "Debug/DebugDrawService.h"
+#include "Engine/Canvas.h"
+#include "Engine/Font.h"
+#include "CanvasItem.h"
+#include "SceneView.h"
+#include "SceneInterface.h"
+#include "Misc/TransactionObjectEvent.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
 
 #define LOCTEXT_NAMESPACE "EditorActorTagDisplay"
 
 auto FEditorActorTagDisplayModule::StartupModule() -> void
 {
-    RegisterDebugDrawDelegate();
     FEditorActorTagDisplayModule::AddViewportShowFlagExtension();
 
+    DumpWriteStatsCommand = IConsoleManager::Get().RegisterConsoleCommand(
+        TEXT("EditorActorTagDisplay.DumpWriteStats"),
+        TEXT("Prints how many label property writes were issued or skipped. Pass 'reset' to clear the counters."),
+        FConsoleCommandWithArgsDelegate::CreateRaw(this, &FEditorActorTagDisplayModule::DumpWriteStats),
+        ECVF_Default);
+
     // フォントサイズ変更デリゲートを購読
     if (UEditorActorTagDisplaySettings *Settings = UEditorActorTagDisplaySettings::Get())
     {
@@ -35,333 +57,2416 @@ auto FEditorActorTagDisplayModule::StartupModule() -> void
 
         OutlineWidthChangedDelegateHandle = Settings->GetOnOutlineWidthChangedDelegate().AddLambda(
             [this](float /*NewOutlineWidth*/) -> void { UpdateAllTextActorOutlineWidth(); });
+
+        TextMaterialChangedDelegateHandle =
+            Settings->GetOnTextMaterialChangedDelegate().AddLambda([this]() -> void { ResetTextMaterials(); });
+
+        // クラス設定が変わった場合はキャッシュを破棄し、次のティックでワールドを再走査する
+        ClassConfigsChangedDelegateHandle =
+            Settings->GetOnClassConfigsChangedDelegate().AddLambda([this]() -> void { InvalidateClassConfigCache(); });
+
+        // 表示が無効な間は毎フレームのティックを止める
+        TagDisplayEnabledChangedDelegateHandle = Settings->GetOnTagDisplayEnabledChangedDelegate().AddRaw(
+            this, &FEditorActorTagDisplayModule::OnTagDisplayEnabledChanged);
+
+        // 描画方式・カリングなど、どの設定の変更でも次のティックで更新させる
+        SettingChangedDelegateHandle = Settings->OnSettingChanged().AddLambda(
+            [this](UObject * /*Object*/, FPropertyChangedEvent & /*PropertyChangedEvent*/) -> void
+            { MarkAllLabelContextsDirty(); });
+
+        // 表示が一度も有効にされるまでは、エディターのイベントの購読もマテリアルの読み込みも行わない
+        if (Settings->IsTagDisplayEnabled())
+        {
+            ActivateModule();
+        }
+    }
+}
+
+auto FEditorActorTagDisplayModule::ActivateModule() -> void
+{
+    if (bIsModuleActive)
+    {
+        return;
     }
+    bIsModuleActive = true;
+
+    RegisterDebugDrawDelegate();
+    RegisterActorTrackingDelegates();
+    RegisterClassCacheDelegates();
+    RequestTextMaterials();
 }
 
 auto FEditorActorTagDisplayModule::ShutdownModule() -> void
 {
+    UnregisterClassCacheDelegates();
+    UnregisterActorTrackingDelegates();
     UnregisterDebugDrawDelegate();
     RemoveViewportShowFlagExtension();
 
+    if (DumpWriteStatsCommand != nullptr)
+    {
+        IConsoleManager::Get().UnregisterConsoleObject(DumpWriteStatsCommand);
+        DumpWriteStatsCommand = nullptr;
+    }
+
     // デリゲートハンドルをリセット
     // デリゲートは自動的に破棄されるため、明示的な削除は不要。
     TextSizeChangedDelegateHandle.Reset();
     OutlineWidthChangedDelegateHandle.Reset();
+    TextMaterialChangedDelegateHandle.Reset();
+    ClassConfigsChangedDelegateHandle.Reset();
+    TagDisplayEnabledChangedDelegateHandle.Reset();
+    SettingChangedDelegateHandle.Reset();
+
+    if (TextMaterialLoadHandle.IsValid())
+    {
+        TextMaterialLoadHandle->CancelHandle();
+        TextMaterialLoadHandle.Reset();
+    }
+    bAreTextMaterialsLoaded = false;
+    bIsModuleActive = false;
+
+    SharedTextMaterial = nullptr;
+    TextBaseMaterial = nullptr;
 }
 
 auto FEditorActorTagDisplayModule::RegisterDebugDrawDelegate() -> void
 {
-    // FTickerを使用してTextRenderComponentを更新
+    // 表示が有効な間のみ、FTickerを使用してTextRenderComponentを更新
+    const UEditorActorTagDisplaySettings *Settings = UEditorActorTagDisplaySettings::Get();
+    if (Settings != nullptr && Settings->IsTagDisplayEnabled())
+    {
+        RegisterUpdateTicker();
+    }
+
+    // キャンバス描画モードのラベルは、開いているすべてのエディタービューポートとPIEのビューポートに描画する
+    DrawDelegateHandle = UDebugDrawService::Register(
+        TEXT("Editor"), FDebugDrawDelegate::CreateRaw(this, &FEditorActorTagDisplayModule::DrawCanvasOverlay, false));
+    GameDrawDelegateHandle = UDebugDrawService::Register(
+        TEXT("Game"), FDebugDrawDelegate::CreateRaw(this, &FEditorActorTagDisplayModule::DrawCanvasOverlay, true));
+
+    // PIEの終了やマップの切り替えで破棄されるワールドのコンテキストを手放す
+    WorldCleanupDelegateHandle =
+        FWorldDelegates::OnWorldCleanup.AddRaw(this, &FEditorActorTagDisplayModule::OnWorldCleanup);
+    PostWorldInitializationDelegateHandle = FWorldDelegates::OnPostWorldInitialization.AddLambda(
+        [this](UWorld * /*World*/, const UWorld::InitializationValues /*IVS*/) -> void
+        { bAreLabelWorldsDirty = true; });
+
+    // PIEの開始・終了で描画されるワールドが切り替わるため、次のティックで更新させる
+    PostPIEStartedDelegateHandle = FEditorDelegates::PostPIEStarted.AddLambda(
+        [this](bool /*bIsSimulating*/) -> void
+        {
+            bAreLabelWorldsDirty = true;
+            MarkAllLabelContextsDirty();
+        });
+    EndPIEDelegateHandle = FEditorDelegates::EndPIE.AddLambda(
+        [this](bool /*bIsSimulating*/) -> void
+        {
+            bAreLabelWorldsDirty = true;
+            MarkAllLabelContextsDirty();
+        });
+}
+
+auto FEditorActorTagDisplayModule::UnregisterDebugDrawDelegate() -> void
+{
+    UnregisterUpdateTicker();
+    UnregisterPoolTrimTicker();
+    if (DrawDelegateHandle.IsValid())
+    {
+        UDebugDrawService::Unregister(DrawDelegateHandle);
+        DrawDelegateHandle.Reset();
+    }
+    if (GameDrawDelegateHandle.IsValid())
+    {
+        UDebugDrawService::Unregister(GameDrawDelegateHandle);
+        GameDrawDelegateHandle.Reset();
+    }
+    FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupDelegateHandle);
+    WorldCleanupDelegateHandle.Reset();
+    FWorldDelegates::OnPostWorldInitialization.Remove(PostWorldInitializationDelegateHandle);
+    PostWorldInitializationDelegateHandle.Reset();
+    FEditorDelegates::PostPIEStarted.Remove(PostPIEStartedDelegateHandle);
+    FEditorDelegates::EndPIE.Remove(EndPIEDelegateHandle);
+    PostPIEStartedDelegateHandle.Reset();
+    EndPIEDelegateHandle.Reset();
+
+    RemoveAllLabelContexts();
+}
+
+auto FEditorActorTagDisplayModule::RegisterUpdateTicker() -> void
+{
+    if (TickDelegateHandle.IsValid())
+    {
+        return;
+    }
+
     TickDelegateHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda(
         [this](float /*DeltaTime*/) -> bool
         {
             UpdateTextActors();
+            UpdateFrameStats();
             return true; // 継続実行
         }));
 }
 
-auto FEditorActorTagDisplayModule::UnregisterDebugDrawDelegate() -> void
+auto FEditorActorTagDisplayModule::UnregisterUpdateTicker() -> void
 {
     if (TickDelegateHandle.IsValid())
     {
         FTSTicker::RemoveTicker(TickDelegateHandle);
+        TickDelegateHandle.Reset();
+    }
+}
+
+auto FEditorActorTagDisplayModule::RegisterPoolTrimTicker() -> void
+{
+    if (PoolTrimTickDelegateHandle.IsValid())
+    {
+        return;
+    }
+
+    // 猶予時間を過ぎたプールのアクターを低頻度で破棄し、プールが空になったら登録を解除する
+    PoolTrimTickDelegateHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateLambda(
+            [this](float /*DeltaTime*/) -> bool
+            {
+                bool bHasPooledActors = false;
+                for (auto &Pair : LabelContexts)
+                {
+                    TrimTextActorPool(*Pair.Value);
+                    bHasPooledActors |= !Pair.Value->TextActorPool.IsEmpty();
+                }
+                if (!bHasPooledActors)
+                {
+                    PoolTrimTickDelegateHandle.Reset();
+                }
+                return bHasPooledActors;
+            }),
+        PoolTrimTickInterval);
+}
+
+auto FEditorActorTagDisplayModule::UnregisterPoolTrimTicker() -> void
+{
+    if (PoolTrimTickDelegateHandle.IsValid())
+    {
+        FTSTicker::RemoveTicker(PoolTrimTickDelegateHandle);
+        PoolTrimTickDelegateHandle.Reset();
+    }
+}
+
+auto FEditorActorTagDisplayModule::OnTagDisplayEnabledChanged(bool bEnabled) -> void
+{
+    if (bEnabled)
+    {
+        ActivateModule();
+        UnregisterPoolTrimTicker();
+        MarkAllLabelContextsDirty();
+        RegisterUpdateTicker();
+        return;
+    }
+
+    // 無効化時にラベルを一度だけプールに戻し、以降はプールの縮小のみ低頻度で行う
+    UnregisterUpdateTicker();
+    for (auto &Pair : LabelContexts)
+    {
+        CleanupTextActors(*Pair.Value);
+    }
+    RegisterPoolTrimTicker();
+}
+
+auto FEditorActorTagDisplayModule::UpdateTextActors() -> void
+{
+    SCOPE_CYCLE_COUNTER(STAT_EditorActorTagDisplay_Update);
+    TRACE_CPUPROFILER_EVENT_SCOPE(EditorActorTagDisplay::UpdateTextActors);
+    CSV_SCOPED_TIMING_STAT(EditorActorTagDisplay, UpdateTextActors);
+
+    // ワールドの構成はワールドの初期化・破棄とPIEの開始・終了でのみ変わるため、その時だけ列挙し直す
+    if (bAreLabelWorldsDirty)
+    {
+        RefreshLabelWorlds();
+    }
+
+    const UEditorActorTagDisplaySettings *Settings = UEditorActorTagDisplaySettings::Get();
+    const bool bIsTagDisplayEnabled = Settings != nullptr && Settings->IsTagDisplayEnabled();
+
+    // 猶予時間を過ぎたプールのアクターは、毎フレームではなく一定間隔で破棄する
+    const double CurrentTime = FPlatformTime::Seconds();
+    const bool bShouldTrimPools = CurrentTime >= NextPoolTrimTime;
+    if (bShouldTrimPools)
+    {
+        NextPoolTrimTime = CurrentTime + PoolTrimTickInterval;
+    }
+
+    for (const TWeakObjectPtr<UWorld> &WeakWorld : LabelWorlds)
+    {
+        UWorld *World = WeakWorld.Get();
+        if (World == nullptr)
+        {
+            continue;
+        }
+
+        // 表示が無効な間も猶予時間を過ぎたプールのアクターは破棄する
+        FLabelContext *Context = bIsTagDisplayEnabled ? &GetOrAddLabelContext(World) : FindLabelContext(World);
+        if (Context == nullptr)
+        {
+            continue;
+        }
+        if (bShouldTrimPools)
+        {
+            TrimTextActorPool(*Context);
+        }
+
+        if (!bIsTagDisplayEnabled)
+        {
+            CleanupTextActors(*Context);
+            continue;
+        }
+
+        // 変化のないフレームでは、カメラの取得と比較以外の処理を行わない
+        if (FEditorActorTagDisplayModule::IsLabelContextIdle(*Context, World, Settings))
+        {
+            continue;
+        }
+
+        // 描画されていないワールド（専用サーバーのPIEワールドや非表示のビューポートなど）は更新を止める
+        // マテリアルの読み込み中は、マテリアルを使う描画方式のラベルを生成しない（完了時に更新させる）
+        const bool bCanCreateLabels = bAreTextMaterialsLoaded ||
+                                      Settings->GetRenderMode() == EEditorActorTagDisplayRenderMode::CanvasOverlay;
+        if (bCanCreateLabels && IsWorldRendered(World))
+        {
+            UpdateLabelContext(*Context, World, Settings);
+        }
+    }
+}
+
+auto FEditorActorTagDisplayModule::RefreshLabelWorlds() -> void
+{
+    FLabelWorldArray Worlds;
+    GetLabelWorlds(Worlds);
+
+    // 表示対象でなくなったワールド（ワールドの差し替えなど）のコンテキストを破棄する
+    TArray<TObjectKey<UWorld>, TInlineAllocator<4>> RemovedWorlds;
+    for (const auto &Pair : LabelContexts)
+    {
+        if (!Worlds.Contains(Pair.Value->World.Get()))
+        {
+            RemovedWorlds.Add(Pair.Key);
+        }
+    }
+    for (const TObjectKey<UWorld> &WorldKey : RemovedWorlds)
+    {
+        RemoveLabelContext(WorldKey, false);
+    }
+
+    LabelWorlds.Reset();
+    for (UWorld *World : Worlds)
+    {
+        LabelWorlds.Add(World);
+    }
+    bAreLabelWorldsDirty = false;
+}
+
+auto FEditorActorTagDisplayModule::UpdateLabelContext(FLabelContext &Context, UWorld *World,
+                                                      const UEditorActorTagDisplaySettings *Settings) -> void
+{
+    // NOLINTNEXTLINE
+    check(World != nullptr);
+    // NOLINTNEXTLINE
+    check(Settings != nullptr);
+
+    // カメラ位置はラベルごとではなくフレームごとに1回だけ取得する
+    Context.bHasFrameCameraView = FEditorActorTagDisplayModule::GetCameraView(World, Context.FrameCameraView);
+    Context.FrameCameraLocation = Context.bHasFrameCameraView ? Context.FrameCameraView.Location : FVector::ZeroVector;
+
+    // 描画方式が切り替わった場合は既存のラベルを破棄して作り直す
+    const EEditorActorTagDisplayRenderMode RenderMode = FEditorActorTagDisplayModule::GetEffectiveRenderMode(Settings);
+    if (RenderMode != Context.ActiveRenderMode)
+    {
+        CleanupTextActors(Context);
+        Context.ActiveRenderMode = RenderMode;
+        if (RenderMode != Settings->GetRenderMode())
+        {
+            // NOLINTNEXTLINE
+            UE_LOG(LogEditorActorTagDisplay, Warning,
+                   TEXT("The label font cannot be batched (only single-page offline fonts are supported). "
+                        "Falling back to Per-Actor render mode."));
+        }
+    }
+
+    // バッチ描画のラベルはカメラの回転が変わった時のみ向きを更新する
+    if (Context.ActiveRenderMode == EEditorActorTagDisplayRenderMode::Batched && Context.bHasFrameCameraView &&
+        Context.BatchActor.IsValid())
+    {
+        Context.BatchActor->GetBatchComponent()->SetFacingRotation(Context.FrameCameraView.Rotation);
+    }
+
+    if (Settings->IsIncrementalUpdateEnabled())
+    {
+        // 変化のないフレームでは、カメラの取得以外の処理を行わない
+        if (FEditorActorTagDisplayModule::ConsumeLabelContextChanges(Context, Settings))
+        {
+            UpdateTextActorsIncremental(Context, World, Settings);
+        }
+        return;
+    }
+
+    // 全走査モードではイベントを蓄積しない（インクリメンタル更新から切り替わった時のみ追跡を解除する）
+    if (Context.bIsTrackingActors)
+    {
+        ResetActorTracking(Context);
+    }
+
+    // 今回の走査で一致したアクターのラベルに世代を記録し、それ以外を破棄する
+    Context.Labels.BeginPass();
+    ProcessActorsInWorld(Context, World, Settings);
+    FlushLabelSnapshot(Context, Settings);
+    RemoveUnusedTextActors(Context);
+}
+
+auto FEditorActorTagDisplayModule::GetLabelWorlds(FLabelWorldArray &OutWorlds) const -> void
+{
+    if (UWorld *World = WorldOverride.Get())
+    {
+        OutWorlds.Add(World);
+        return;
+    }
+
+    if (GEngine == nullptr)
+    {
+        return;
+    }
+
+    // エディターワールドと、マルチクライアントを含むすべてのPIEワールド
+    for (const FWorldContext &WorldContext : GEngine->GetWorldContexts())
+    {
+        UWorld *World = WorldContext.World();
+        if (World != nullptr &&
+            (WorldContext.WorldType == EWorldType::Editor || WorldContext.WorldType == EWorldType::PIE))
+        {
+            OutWorlds.Add(World);
+        }
+    }
+}
+
+auto FEditorActorTagDisplayModule::IsWorldRendered(UWorld *World) const -> bool
+{
+    // NOLINTNEXTLINE
+    check(World != nullptr);
+
+    // ベンチマーク用のワールドはビューポートを持たない
+    if (World == WorldOverride.Get())
+    {
+        return true;
+    }
+
+    // PIEのゲームビューポート（専用サーバーのワールドは持たない）
+    if (GEngine != nullptr)
+    {
+        const FWorldContext *WorldContext = GEngine->GetWorldContextFromWorld(World);
+        if (WorldContext != nullptr && WorldContext->GameViewport != nullptr &&
+            WorldContext->GameViewport->Viewport != nullptr &&
+            WorldContext->GameViewport->Viewport->GetSizeXY().GetMin() > 0)
+        {
+            return true;
+        }
+    }
+
+    // レベルエディターのビューポート（Simulate In Editorを含む）
+    if (GEditor != nullptr)
+    {
+        for (const FEditorViewportClient *ViewportClient : GEditor->GetAllViewportClients())
+        {
+            if (ViewportClient != nullptr && ViewportClient->GetWorld() == World && ViewportClient->IsVisible())
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+auto FEditorActorTagDisplayModule::FindLabelContext(const UWorld *World) -> FLabelContext *
+{
+    if (World == nullptr)
+    {
+        return nullptr;
+    }
+
+    const TUniquePtr<FLabelContext> *Context = LabelContexts.Find(World);
+    return Context != nullptr ? Context->Get() : nullptr;
+}
+
+auto FEditorActorTagDisplayModule::GetOrAddLabelContext(UWorld *World) -> FLabelContext &
+{
+    // NOLINTNEXTLINE
+    check(World != nullptr);
+
+    TUniquePtr<FLabelContext> &Context = LabelContexts.FindOrAdd(World);
+    if (!Context.IsValid())
+    {
+        Context = MakeUnique<FLabelContext>();
+        Context->World = World;
+
+        // プログラムからの移動（シーケンサーなど）はルートコンポーネントの通知で検出する
+        Context->AnchorCache.GetOnAnchorInvalidated().BindRaw(this, &FEditorActorTagDisplayModule::MarkActorDirty);
+    }
+    return *Context;
+}
+
+auto FEditorActorTagDisplayModule::RemoveLabelContext(const TObjectKey<UWorld> &WorldKey, bool bIsWorldTornDown)
+    -> void
+{
+    TUniquePtr<FLabelContext> *FoundContext = LabelContexts.Find(WorldKey);
+    if (FoundContext == nullptr)
+    {
+        return;
+    }
+    const TUniquePtr<FLabelContext> Context = MoveTemp(*FoundContext);
+    LabelContexts.Remove(WorldKey);
+    if (!Context.IsValid())
+    {
+        return;
+    }
+
+    // 破棄されるワールドのラベルとプールはワールドと共に破棄されるため、購読の解除のみ行う
+    if (bIsWorldTornDown)
+    {
+        ResetActorTracking(*Context);
+    }
+    else
+    {
+        CleanupTextActors(*Context);
+        EmptyTextActorPool(*Context);
+    }
+    Context->AnchorCache.GetOnAnchorInvalidated().Unbind();
+}
+
+auto FEditorActorTagDisplayModule::RemoveAllLabelContexts() -> void
+{
+    TArray<TObjectKey<UWorld>, TInlineAllocator<4>> WorldKeys;
+    LabelContexts.GetKeys(WorldKeys);
+    for (const TObjectKey<UWorld> &WorldKey : WorldKeys)
+    {
+        RemoveLabelContext(WorldKey, false);
+    }
+}
+
+auto FEditorActorTagDisplayModule::OnWorldCleanup(UWorld *World, bool /*bSessionEnded*/, bool /*bCleanupResources*/)
+    -> void
+{
+    RemoveLabelContext(World, true);
+    bAreLabelWorldsDirty = true;
+
+    // 破棄されるアクターの値の文字列を残さない
+    ConfigMatcher.InvalidateAllValueTexts();
+}
+
+auto FEditorActorTagDisplayModule::ConsumeLabelContextChanges(FLabelContext &Context,
+                                                              const UEditorActorTagDisplaySettings *Settings) -> bool
+{
+    // NOLINTNEXTLINE
+    check(Settings != nullptr);
+
+    // ワールドの変更はイベントで予約済みの処理として、設定・PIEの変更はフラグとして蓄積されている
+    const bool bHasChanges = Context.bIsDirty || Context.bNeedsFullSweep || !Context.DirtyActors.IsEmpty() ||
+                             !Context.PendingLabelWork.IsEmpty() ||
+                             FEditorActorTagDisplayModule::HasCameraMoved(Context);
+    if (bHasChanges)
+    {
+        Context.bIsDirty = false;
+        Context.LastUpdateCameraView = Context.FrameCameraView;
+        Context.bHasLastUpdateCameraView = Context.bHasFrameCameraView;
+
+        // 遠いラベルの向きは数フレームに1回ずつ更新されるため、一巡するまでは更新を続ける
+        Context.NumSettleFrames = FMath::Max(Settings->GetFarLabelRefreshInterval(), 1);
+        return true;
+    }
+
+    if (Context.NumSettleFrames > 0)
+    {
+        --Context.NumSettleFrames;
+        return true;
+    }
+    return false;
+}
+
+auto FEditorActorTagDisplayModule::HasCameraMoved(const FLabelContext &Context) -> bool
+{
+    if (Context.bHasFrameCameraView != Context.bHasLastUpdateCameraView)
+    {
+        return true;
+    }
+    if (!Context.bHasFrameCameraView)
+    {
+        return false;
+    }
+
+    // 前回更新したフレームからの累積の変化で判定し、ゆっくりした移動も取りこぼさない
+    const FMinimalViewInfo &Current = Context.FrameCameraView;
+    const FMinimalViewInfo &Last = Context.LastUpdateCameraView;
+    return FVector::DistSquared(Current.Location, Last.Location) > FMath::Square(IdleCameraLocationThreshold) ||
+           !Current.Rotation.Equals(Last.Rotation, IdleCameraRotationThreshold) ||
+           FMath::Abs(Current.FOV - Last.FOV) > IdleCameraFOVThreshold ||
+           Current.ProjectionMode != Last.ProjectionMode ||
+           !FMath::IsNearlyEqual(Current.OrthoWidth, Last.OrthoWidth) ||
+           !FMath::IsNearlyEqual(Current.AspectRatio, Last.AspectRatio);
+}
+
+auto FEditorActorTagDisplayModule::IsLabelContextIdle(FLabelContext &Context, UWorld *World,
+                                                      const UEditorActorTagDisplaySettings *Settings) -> bool
+{
+    // NOLINTNEXTLINE
+    check(Settings != nullptr);
+
+    // 全走査モードはイベントを蓄積しないため、変化の有無を判定できない
+    if (!Settings->IsIncrementalUpdateEnabled() ||
+        FEditorActorTagDisplayModule::GetEffectiveRenderMode(Settings) != Context.ActiveRenderMode ||
+        Context.bIsDirty || Context.bNeedsFullSweep || !Context.DirtyActors.IsEmpty() ||
+        !Context.PendingLabelWork.IsEmpty() || Context.NumSettleFrames > 0)
+    {
+        return false;
+    }
+
+    Context.bHasFrameCameraView = FEditorActorTagDisplayModule::GetCameraView(World, Context.FrameCameraView);
+    Context.FrameCameraLocation = Context.bHasFrameCameraView ? Context.FrameCameraView.Location : FVector::ZeroVector;
+    return !FEditorActorTagDisplayModule::HasCameraMoved(Context);
+}
+
+auto FEditorActorTagDisplayModule::MarkAllLabelContextsDirty() -> void
+{
+    for (auto &Pair : LabelContexts)
+    {
+        Pair.Value->bIsDirty = true;
+    }
+}
+
+auto FEditorActorTagDisplayModule::UpdateTextActorsIncremental(FLabelContext &Context, UWorld *World,
+                                                               const UEditorActorTagDisplaySettings *Settings) -> void
+{
+    // NOLINTNEXTLINE
+    check(World != nullptr);
+    // NOLINTNEXTLINE
+    check(Settings != nullptr);
+
+    if (!Context.bIsTrackingActors)
+    {
+        Context.bIsTrackingActors = true;
+
+        // エディターでのサブレベルの追加・削除・表示切り替えはレベル構成の変更として通知される
+        Context.LevelsChangedDelegateHandle = World->OnLevelsChanged().AddLambda(
+            [this, &Context]() -> void
+            {
+                if (UWorld *ContextWorld = Context.World.Get())
+                {
+                    ReconcileTrackedLevels(Context, ContextWorld);
+                }
+            });
+    }
+
+    if (Context.bNeedsFullSweep)
+    {
+        SweepTrackedWorld(Context, World);
+        Context.bNeedsFullSweep = false;
+    }
+
+    // 絞り込みが無効になった場合は、ラベルを持たない追跡中のアクターにもラベルを生成させる
+    FConvexVolume ViewFrustum;
+    // キャンバス描画はビューごとに投影時にカリングするため、アクティブなビューでは絞り込まない
+    const bool bCullingActive = Settings->IsViewCullingEnabled() && Context.bHasFrameCameraView &&
+                                Context.ActiveRenderMode != EEditorActorTagDisplayRenderMode::CanvasOverlay &&
+                                FEditorActorTagDisplayModule::ComputeViewFrustum(Context.FrameCameraView, ViewFrustum);
+    // カリングしない場合（無効時・平行投影ビュー）も、上限を超えるアクターを追跡中であれば全体から選んで適用する
+    const bool bVisibleSetActive =
+        bCullingActive || (FEditorActorTagDisplayModule::ShouldLimitVisibleLabels(Context, Settings) &&
+                           Context.SpatialIndex.Num() > Settings->GetMaxVisibleLabels());
+    if (bVisibleSetActive != Context.bIsVisibleSetActive)
+    {
+        Context.bIsVisibleSetActive = bVisibleSetActive;
+        if (!bVisibleSetActive)
+        {
+            MarkTrackedActorsDirty(Context);
+        }
+    }
+
+    // 既存ラベルの向きを先に更新し、生成・更新は優先度順に予算内で処理する
+    RefreshTextActorRotations(Context, Settings);
+    ProcessDirtyActors(Context, World, Settings);
+
+    if (Context.bIsVisibleSetActive)
+    {
+        MaterializeVisibleLabels(Context, Settings, bCullingActive ? &ViewFrustum : nullptr);
+    }
+
+    DrainLabelWork(Context, Settings);
+}
+
+auto FEditorActorTagDisplayModule::SweepTrackedWorld(FLabelContext &Context, UWorld *World) -> void
+{
+    SCOPE_CYCLE_COUNTER(STAT_EditorActorTagDisplay_SweepTrackedWorld);
+    TRACE_CPUPROFILER_EVENT_SCOPE(EditorActorTagDisplay::SweepTrackedWorld);
+
+    // NOLINTNEXTLINE
+    check(World != nullptr);
+
+    // 追跡中のアクターも再評価対象にして、一致しなくなったアクターのラベルを削除する
+    MarkTrackedActorsDirty(Context);
+    ReconcileTrackedLevels(Context, World);
+
+    // 設定変更などで全体を再評価する場合は、登録済みのレベルの候補も集め直す
+    for (const auto &Pair : Context.TrackedLevels)
+    {
+        const ULevel *Level = Pair.Value.Level.Get();
+        if (Level == nullptr)
+        {
+            continue;
+        }
+
+        for (AActor *Actor : Level->Actors)
+        {
+            if (Actor != nullptr && IsValid(Actor) && MayShowLabel(Actor))
+            {
+                Context.DirtyActors.Add(Actor);
+            }
+        }
+    }
+}
+
+auto FEditorActorTagDisplayModule::MarkTrackedActorsDirty(FLabelContext &Context) -> void
+{
+    Context.DirtyActors.Reserve(Context.DirtyActors.Num() + Context.TrackedActors.Num());
+    for (const auto &Pair : Context.TrackedActors)
+    {
+        Context.DirtyActors.Add(Pair.Key);
+    }
+}
+
+auto FEditorActorTagDisplayModule::ReconcileTrackedLevels(FLabelContext &Context, UWorld *World) -> void
+{
+    // NOLINTNEXTLINE
+    check(World != nullptr);
+
+    // 表示中のレベルを登録し、ワールドから外れたか非表示になったレベルを破棄する
+    TSet<TObjectKey<ULevel>> VisibleLevels;
+    for (ULevel *Level : World->GetLevels())
+    {
+        if (Level != nullptr && Level->bIsVisible)
+        {
+            VisibleLevels.Add(Level);
+            RegisterTrackedLevel(Context, Level);
+        }
+    }
+
+    TArray<TObjectKey<ULevel>> RemovedLevels;
+    for (const auto &Pair : Context.TrackedLevels)
+    {
+        if (!VisibleLevels.Contains(Pair.Key))
+        {
+            RemovedLevels.Add(Pair.Key);
+        }
+    }
+    for (const TObjectKey<ULevel> &LevelKey : RemovedLevels)
+    {
+        UnregisterTrackedLevel(Context, LevelKey);
+    }
+}
+
+auto FEditorActorTagDisplayModule::RegisterTrackedLevel(FLabelContext &Context, ULevel *Level) -> void
+{
+    // NOLINTNEXTLINE
+    check(Level != nullptr);
+
+    if (Context.TrackedLevels.Contains(Level))
+    {
+        return;
+    }
+
+    FTrackedLevel &TrackedLevel = Context.TrackedLevels.Add(Level);
+    TrackedLevel.Level = Level;
+    TrackedLevel.LoadedActorAddedHandle =
+        Level->OnLoadedActorAddedToLevelEvent.AddRaw(this, &FEditorActorTagDisplayModule::OnLoadedActorAdded);
+    TrackedLevel.LoadedActorRemovedHandle =
+        Level->OnLoadedActorRemovedFromLevelEvent.AddRaw(this, &FEditorActorTagDisplayModule::OnLoadedActorRemoved);
+
+    // レベル内の候補をまとめて次のティックの1回の処理に載せる
+    for (AActor *Actor : Level->Actors)
+    {
+        if (Actor != nullptr && IsValid(Actor) && MayShowLabel(Actor))
+        {
+            Context.DirtyActors.Add(Actor);
+        }
+    }
+}
+
+auto FEditorActorTagDisplayModule::UnregisterTrackedLevel(FLabelContext &Context, const TObjectKey<ULevel> &LevelKey)
+    -> void
+{
+    FTrackedLevel TrackedLevel;
+    if (!Context.TrackedLevels.RemoveAndCopyValue(LevelKey, TrackedLevel))
+    {
+        return;
+    }
+
+    if (ULevel *Level = TrackedLevel.Level.Get())
+    {
+        Level->OnLoadedActorAddedToLevelEvent.Remove(TrackedLevel.LoadedActorAddedHandle);
+        Level->OnLoadedActorRemovedFromLevelEvent.Remove(TrackedLevel.LoadedActorRemovedHandle);
+    }
+
+    // ワールド全体を走査せず、このレベルで追跡していたアクターのラベルだけを破棄する
+    for (const TWeakObjectPtr<AActor> &Actor : TrackedLevel.Actors)
+    {
+        Context.TrackedActors.Remove(Actor);
+        Context.DirtyActors.Remove(Actor);
+        Context.AnchorCache.Remove(Actor);
+        Context.SpatialIndex.Remove(Actor);
+        Context.PendingLabelWork.Remove(Actor);
+        RemoveTextActor(Context, Actor);
+    }
+}
+
+auto FEditorActorTagDisplayModule::OnLevelAddedToWorld(ULevel *Level, UWorld *World) -> void
+{
+    FLabelContext *Context = FindLabelContext(World);
+    if (Level != nullptr && Context != nullptr && Context->bIsTrackingActors && Level->bIsVisible)
+    {
+        RegisterTrackedLevel(*Context, Level);
+    }
+}
+
+auto FEditorActorTagDisplayModule::OnLevelRemovedFromWorld(ULevel *Level, UWorld *World) -> void
+{
+    FLabelContext *Context = FindLabelContext(World);
+    if (Context == nullptr || !Context->bIsTrackingActors)
+    {
+        return;
+    }
+
+    // レベルがnullptrの場合はワールド全体が破棄される
+    if (Level == nullptr)
+    {
+        RemoveLabelContext(World, true);
+        return;
+    }
+
+    UnregisterTrackedLevel(*Context, Level);
+}
+
+auto FEditorActorTagDisplayModule::OnLoadedActorAdded(AActor &Actor) -> void
+{
+    if (MayShowLabel(&Actor))
+    {
+        MarkActorDirty(&Actor);
+    }
+}
+
+auto FEditorActorTagDisplayModule::OnLoadedActorRemoved(AActor &Actor) -> void
+{
+    // 読み込み解除されたアクターは破棄通知を経ずに消えるため、ここで追跡から外す
+    if (FLabelContext *Context = FindLabelContext(Actor.GetWorld()))
+    {
+        UntrackActor(*Context, &Actor);
+        Context->DirtyActors.Remove(&Actor);
+    }
+}
+
+auto FEditorActorTagDisplayModule::UntrackActor(FLabelContext &Context, const TWeakObjectPtr<AActor> &Actor) -> void
+{
+    TObjectKey<ULevel> LevelKey;
+    if (Context.TrackedActors.RemoveAndCopyValue(Actor, LevelKey))
+    {
+        if (FTrackedLevel *TrackedLevel = Context.TrackedLevels.Find(LevelKey))
+        {
+            TrackedLevel->Actors.Remove(Actor);
+        }
+    }
+
+    Context.AnchorCache.Remove(Actor);
+    Context.SpatialIndex.Remove(Actor);
+    Context.PendingLabelWork.Remove(Actor);
+    RemoveTextActor(Context, Actor);
+}
+
+auto FEditorActorTagDisplayModule::ProcessDirtyActors(FLabelContext &Context, UWorld *World,
+                                                      const UEditorActorTagDisplaySettings *Settings) -> void
+{
+    SCOPE_CYCLE_COUNTER(STAT_EditorActorTagDisplay_ProcessDirtyActors);
+    TRACE_CPUPROFILER_EVENT_SCOPE(EditorActorTagDisplay::ProcessDirtyActors);
+
+    // NOLINTNEXTLINE
+    check(World != nullptr);
+    // NOLINTNEXTLINE
+    check(Settings != nullptr);
+
+    for (const TWeakObjectPtr<AActor> &WeakActor : Context.DirtyActors)
+    {
+        AActor *Actor = WeakActor.Get();
+        const bool bIsCandidate =
+            Actor != nullptr && IsValid(Actor) && Actor->GetWorld() == World && MayShowLabel(Actor);
+
+        // 表示中のレベルに属するアクターのみを対象にする
+        ULevel *Level = bIsCandidate ? Actor->GetLevel() : nullptr;
+        FTrackedLevel *TrackedLevel = Level != nullptr ? Context.TrackedLevels.Find(Level) : nullptr;
+        const FActorClassTagDisplayConfig *Config =
+            TrackedLevel != nullptr ? FindMatchingConfig(Actor, Settings) : nullptr;
+
+        if (Config == nullptr)
+        {
+            UntrackActor(Context, WeakActor);
+            continue;
+        }
+
+        // 別のレベルに移動した場合は、以前のレベルから外す
+        TObjectKey<ULevel> &TrackedLevelKey = Context.TrackedActors.FindOrAdd(WeakActor, Level);
+        if (TrackedLevelKey != TObjectKey<ULevel>(Level))
+        {
+            if (FTrackedLevel *PreviousLevel = Context.TrackedLevels.Find(TrackedLevelKey))
+            {
+                PreviousLevel->Actors.Remove(WeakActor);
+            }
+            TrackedLevelKey = Level;
+        }
+        TrackedLevel->Actors.Add(WeakActor);
+
+        Context.SpatialIndex.Update(Actor, ComputeTextPosition(Context, Actor, *Config));
+
+        // 絞り込み中は可視判定後に生成するため、ここでは既存のラベルのみ更新を予約する
+        if (!Context.bIsVisibleSetActive || Context.Labels.Contains(WeakActor))
+        {
+            Context.PendingLabelWork.FindOrAdd(WeakActor).bRefresh = true;
+        }
+    }
+
+    Context.DirtyActors.Reset();
+}
+
+auto FEditorActorTagDisplayModule::RefreshTextActorRotations(FLabelContext &Context,
+                                                             const UEditorActorTagDisplaySettings *Settings) -> void
+{
+    SCOPE_CYCLE_COUNTER(STAT_EditorActorTagDisplay_RefreshRotations);
+    TRACE_CPUPROFILER_EVENT_SCOPE(EditorActorTagDisplay::RefreshTextActorRotations);
+
+    // NOLINTNEXTLINE
+    check(Settings != nullptr);
+
+    // 向きを書き込むラベルアクターを持つのは個別描画モードのみ
+    if (bIsMaterialBillboardActive || Context.ActiveRenderMode != EEditorActorTagDisplayRenderMode::PerActor)
+    {
+        return;
+    }
+
+    // 遠くのラベルは向きの変化が目立たないため、数フレームに1回ずつ順番に更新する
+    ++Context.RotationRefreshFrame;
+    const double FarDistanceSquared = FMath::Square(static_cast<double>(Settings->GetFarLabelDistance()));
+    const uint32 FarRefreshInterval = static_cast<uint32>(FMath::Max(Settings->GetFarLabelRefreshInterval(), 1));
+
+    // 距離はラベルアクターではなくテーブルに記録した位置で判定する
+    Context.Labels.ForEachLabel(
+        [this, &Context, FarDistanceSquared, FarRefreshInterval](int32 LabelHandle) -> void
+        {
+            const FVector &TextPosition = Context.Labels.GetAnchor(LabelHandle);
+            if (FVector::DistSquared(TextPosition, Context.FrameCameraLocation) > FarDistanceSquared &&
+                (Context.RotationRefreshFrame + static_cast<uint32>(LabelHandle)) % FarRefreshInterval != 0U)
+            {
+                return;
+            }
+
+            const FRotator LookAtRotation =
+                FEditorActorTagDisplayLabelSnapshot::ComputeLookAtRotation(TextPosition, Context.FrameCameraLocation);
+            UpdateTextActorRotation(Context, Context.Labels.GetEntry(LabelHandle), LookAtRotation);
+        });
+}
+
+auto FEditorActorTagDisplayModule::DrainLabelWork(FLabelContext &Context,
+                                                  const UEditorActorTagDisplaySettings *Settings) -> void
+{
+    SCOPE_CYCLE_COUNTER(STAT_EditorActorTagDisplay_DrainLabelWork);
+    TRACE_CPUPROFILER_EVENT_SCOPE(EditorActorTagDisplay::DrainLabelWork);
+
+    // NOLINTNEXTLINE
+    check(Settings != nullptr);
+
+    if (Context.PendingLabelWork.IsEmpty())
+    {
+        return;
+    }
+
+    // カメラに近いものほど、また新たに可視になったものほど優先する
+    // 距離はカリング・空間インデックスと同じくラベルの表示位置（基準位置とクラスの位置オフセット）で測る
+    const TArray<FActorClassTagDisplayConfig> &ClassConfigs = Settings->GetClassConfigs();
+    ScheduledLabelWork.Reset();
+    for (auto It = Context.PendingLabelWork.CreateIterator(); It; ++It)
+    {
+        AActor *Actor = It.Key().Get();
+        if (Actor == nullptr)
+        {
+            It.RemoveCurrent();
+            continue;
+        }
+
+        const int32 ConfigIndex = FindMatchingConfigIndex(Actor->GetClass(), Settings);
+        const FVector TextPosition = ClassConfigs.IsValidIndex(ConfigIndex)
+                                         ? ComputeTextPosition(Context, Actor, ClassConfigs[ConfigIndex])
+                                         : Actor->GetActorLocation();
+        const double Distance = FVector::Dist(TextPosition, Context.FrameCameraLocation);
+        FScheduledLabelWork &Work = ScheduledLabelWork.AddDefaulted_GetRef();
+        Work.Actor = It.Key();
+        Work.Priority = It.Value().bCreate ? Distance * NewlyVisiblePriorityScale : Distance;
+    }
+
+    const auto ByPriority = [](const FScheduledLabelWork &A, const FScheduledLabelWork &B) -> bool
+    { return A.Priority < B.Priority; };
+    ScheduledLabelWork.Heapify(ByPriority);
+
+    // スナップショット単位でまとめて並列処理し、予算を使い切った残りは次のフレームに持ち越す
+    // （最初のバッチは必ず処理して枯渇を防ぐ）
+    const double BudgetSeconds = static_cast<double>(Settings->GetUpdateBudgetMs()) / 1000.0;
+    const double StartTime = FPlatformTime::Seconds();
+    while (!ScheduledLabelWork.IsEmpty())
+    {
+        if (LabelSnapshot.Num() >= LabelSnapshotBatchSize)
+        {
+            FlushLabelSnapshot(Context, Settings);
+            if (BudgetSeconds > 0.0 && FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+            {
+                break;
+            }
+        }
+
+        FScheduledLabelWork Work;
+        ScheduledLabelWork.HeapPop(Work, ByPriority, EAllowShrinking::No);
+
+        FPendingLabelWork Pending;
+        if (Context.PendingLabelWork.RemoveAndCopyValue(Work.Actor, Pending))
+        {
+            ExecuteLabelWork(Context, Work.Actor, Pending, Settings);
+        }
+    }
+
+    FlushLabelSnapshot(Context, Settings);
+}
+
+auto FEditorActorTagDisplayModule::ExecuteLabelWork(FLabelContext &Context, const TWeakObjectPtr<AActor> &WeakActor,
+                                                    const FPendingLabelWork &Work,
+                                                    const UEditorActorTagDisplaySettings *Settings) -> void
+{
+    // NOLINTNEXTLINE
+    check(Settings != nullptr);
+
+    AActor *Actor = WeakActor.Get();
+    if (Actor == nullptr || !IsValid(Actor))
+    {
+        return;
+    }
+
+    // 絞り込み中は、ラベルを持たないアクターには可視の場合のみ生成する
+    const bool bHasLabel = Context.Labels.Contains(WeakActor);
+    if (Context.bIsVisibleSetActive && !bHasLabel && Work.VisibleGeneration != Context.Labels.GetGeneration())
+    {
+        return;
+    }
+
+    // 生成要求のみで既にラベルがある場合は何もしない
+    if (!Work.bRefresh && bHasLabel)
+    {
+        return;
+    }
+
+    const int32 ConfigIndex = FindMatchingConfigIndex(Actor->GetClass(), Settings);
+    if (ConfigIndex != INDEX_NONE)
+    {
+        SnapshotLabel(Context, Actor, ConfigIndex, Settings);
+    }
+}
+
+auto FEditorActorTagDisplayModule::SnapshotLabel(FLabelContext &Context, AActor *Actor, int32 ConfigIndex,
+                                                 const UEditorActorTagDisplaySettings *Settings) -> void
+{
+    // NOLINTNEXTLINE
+    check(Actor != nullptr);
+    // NOLINTNEXTLINE
+    check(Settings != nullptr);
+
+    // 既に同じタグを書き込んでいるラベルは、ワーカーで文字列を組み立てない
+    const int32 LabelHandle = Context.Labels.Find(Actor);
+    const bool bHasKnownTagsHash =
+        LabelHandle != INDEX_NONE && Context.Labels.GetEntry(LabelHandle).bIsFingerprintValid;
+    const FActorClassTagDisplayConfig &Config = Settings->GetClassConfigs()[ConfigIndex];
+    const FVector AnchorPosition = Context.bIsTrackingActors
+                                       ? Context.AnchorCache.GetAnchor(Actor, Config)
+                                       : FEditorActorTagDisplayAnchorCache::ComputeAnchor(Actor, Config);
+    LabelSnapshot.Add(Actor, ConfigIndex, ConfigMatcher, Settings->GetClassConfigs(), AnchorPosition,
+                      Config.PositionOffset, bHasKnownTagsHash ? Context.Labels.GetTextHash(LabelHandle) : 0U,
+                      bHasKnownTagsHash);
+}
+
+auto FEditorActorTagDisplayModule::FlushLabelSnapshot(FLabelContext &Context,
+                                                      const UEditorActorTagDisplaySettings *Settings) -> void
+{
+    // NOLINTNEXTLINE
+    check(Settings != nullptr);
+
+    if (LabelSnapshot.Num() == 0)
+    {
+        return;
+    }
+
+    // 文字列・位置・回転はワーカーで計算し、ゲームスレッドでは変化した結果のみを書き込む
+    LabelSnapshot.Build(Context.FrameCameraLocation);
+
+    const TArray<FActorClassTagDisplayConfig> &ClassConfigs = Settings->GetClassConfigs();
+    for (int32 Index = 0; Index < LabelSnapshot.Num(); ++Index)
+    {
+        AActor *Actor = LabelSnapshot.GetActor(Index).Get();
+        const int32 ConfigIndex = LabelSnapshot.GetConfigIndex(Index);
+        if (Actor != nullptr && ClassConfigs.IsValidIndex(ConfigIndex))
+        {
+            CreateOrUpdateTextActor(Context, Actor, ClassConfigs[ConfigIndex], Index);
+        }
+    }
+
+    LabelSnapshot.Reset();
+}
+
+auto FEditorActorTagDisplayModule::RemoveTextActor(FLabelContext &Context, const TWeakObjectPtr<AActor> &Actor) -> void
+{
+    const int32 LabelHandle = Context.Labels.Find(Actor);
+    if (LabelHandle != INDEX_NONE)
+    {
+        ReleaseTextActorEntry(Context, Context.Labels.GetEntry(LabelHandle));
+        Context.Labels.Remove(LabelHandle);
+    }
+}
+
+auto FEditorActorTagDisplayModule::ResetActorTracking(FLabelContext &Context) -> void
+{
+    if (UWorld *World = Context.World.Get())
+    {
+        World->OnLevelsChanged().Remove(Context.LevelsChangedDelegateHandle);
+    }
+    Context.LevelsChangedDelegateHandle.Reset();
+
+    // ラベルは呼び出し元で破棄済みのため、レベルごとの購読のみ解除する
+    for (auto &Pair : Context.TrackedLevels)
+    {
+        if (ULevel *Level = Pair.Value.Level.Get())
+        {
+            Level->OnLoadedActorAddedToLevelEvent.Remove(Pair.Value.LoadedActorAddedHandle);
+            Level->OnLoadedActorRemovedFromLevelEvent.Remove(Pair.Value.LoadedActorRemovedHandle);
+        }
+    }
+    Context.TrackedLevels.Reset();
+
+    Context.bIsTrackingActors = false;
+    Context.TrackedActors.Reset();
+    Context.DirtyActors.Reset();
+    Context.SpatialIndex.Reset();
+    Context.AnchorCache.Reset();
+    Context.PendingLabelWork.Reset();
+    Context.bNeedsFullSweep = true;
+    Context.bIsVisibleSetActive = false;
+}
+
+auto FEditorActorTagDisplayModule::MarkActorDirty(AActor *Actor) -> void
+{
+    // 追跡中のワールド以外のアクターと、プラグイン自身が生成したアクターは無視する
+    if (Actor == nullptr || Actor->IsA<AEditorActorTagDisplayActor>())
+    {
+        return;
+    }
+    FLabelContext *Context = FindLabelContext(Actor->GetWorld());
+    if (Context == nullptr || !Context->bIsTrackingActors)
+    {
+        return;
+    }
+
+    // 再評価のきっかけになる変更はすべてラベルの基準位置も変え得る
+    Context->AnchorCache.Invalidate(Actor);
+    Context->DirtyActors.Add(Actor);
+}
+
+auto FEditorActorTagDisplayModule::RegisterActorTrackingDelegates() -> void
+{
+    if (GEngine != nullptr)
+    {
+        LevelActorAddedDelegateHandle =
+            GEngine->OnLevelActorAdded().AddRaw(this, &FEditorActorTagDisplayModule::OnLevelActorAdded);
+        LevelActorDeletedDelegateHandle =
+            GEngine->OnLevelActorDeleted().AddRaw(this, &FEditorActorTagDisplayModule::OnLevelActorDeleted);
+        ActorMovedDelegateHandle = GEngine->OnActorMoved().AddRaw(this, &FEditorActorTagDisplayModule::OnActorMoved);
+        ActorMovingDelegateHandle =
+            GEngine->OnActorMoving().AddRaw(this, &FEditorActorTagDisplayModule::OnActorMoved);
+    }
+
+    ObjectPropertyChangedDelegateHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(
+        this, &FEditorActorTagDisplayModule::OnObjectPropertyChanged);
+    ObjectTransactedDelegateHandle =
+        FCoreUObjectDelegates::OnObjectTransacted.AddRaw(this, &FEditorActorTagDisplayModule::OnObjectTransacted);
+
+    // レベルストリーミング・World Partitionによるレベルの追加・削除
+    LevelAddedToWorldDelegateHandle =
+        FWorldDelegates::LevelAddedToWorld.AddRaw(this, &FEditorActorTagDisplayModule::OnLevelAddedToWorld);
+    LevelRemovedFromWorldDelegateHandle =
+        FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &FEditorActorTagDisplayModule::OnLevelRemovedFromWorld);
+
+    // コリジョンを持つコンポーネントの登録・解除はバウンディングボックスを変える
+    // （コリジョンのないコンポーネントはトランザクションの確定で検出し、ゲームワールドではキャッシュしない）
+    ComponentCreatePhysicsDelegateHandle = UActorComponent::GlobalCreatePhysicsDelegate.AddRaw(
+        this, &FEditorActorTagDisplayModule::OnComponentPhysicsStateChanged);
+    ComponentDestroyPhysicsDelegateHandle = UActorComponent::GlobalDestroyPhysicsDelegate.AddRaw(
+        this, &FEditorActorTagDisplayModule::OnComponentPhysicsStateChanged);
+}
+
+auto FEditorActorTagDisplayModule::UnregisterActorTrackingDelegates() -> void
+{
+    if (GEngine != nullptr)
+    {
+        GEngine->OnLevelActorAdded().Remove(LevelActorAddedDelegateHandle);
+        GEngine->OnLevelActorDeleted().Remove(LevelActorDeletedDelegateHandle);
+        GEngine->OnActorMoved().Remove(ActorMovedDelegateHandle);
+        GEngine->OnActorMoving().Remove(ActorMovingDelegateHandle);
+    }
+
+    FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(ObjectPropertyChangedDelegateHandle);
+    FCoreUObjectDelegates::OnObjectTransacted.Remove(ObjectTransactedDelegateHandle);
+    UActorComponent::GlobalCreatePhysicsDelegate.Remove(ComponentCreatePhysicsDelegateHandle);
+    UActorComponent::GlobalDestroyPhysicsDelegate.Remove(ComponentDestroyPhysicsDelegateHandle);
+    FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedToWorldDelegateHandle);
+    FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedFromWorldDelegateHandle);
+
+    LevelActorAddedDelegateHandle.Reset();
+    LevelActorDeletedDelegateHandle.Reset();
+    ActorMovedDelegateHandle.Reset();
+    ActorMovingDelegateHandle.Reset();
+    ObjectPropertyChangedDelegateHandle.Reset();
+    ObjectTransactedDelegateHandle.Reset();
+    ComponentCreatePhysicsDelegateHandle.Reset();
+    ComponentDestroyPhysicsDelegateHandle.Reset();
+    LevelAddedToWorldDelegateHandle.Reset();
+    LevelRemovedFromWorldDelegateHandle.Reset();
+
+    for (auto &Pair : LabelContexts)
+    {
+        ResetActorTracking(*Pair.Value);
+    }
+}
+
+auto FEditorActorTagDisplayModule::OnLevelActorAdded(AActor *Actor) -> void
+{
+    MarkActorDirty(Actor);
+}
+
+auto FEditorActorTagDisplayModule::OnLevelActorDeleted(AActor *Actor) -> void
+{
+    // 削除されたアクターは次のティックでIsValidが偽になり、ラベルが削除される
+    ConfigMatcher.InvalidateValueText(Actor);
+    MarkActorDirty(Actor);
+}
+
+auto FEditorActorTagDisplayModule::OnActorMoved(AActor *Actor) -> void
+{
+    const FLabelContext *Context = Actor != nullptr ? FindLabelContext(Actor->GetWorld()) : nullptr;
+    if (Context != nullptr && Context->TrackedActors.Contains(Actor))
+    {
+        MarkActorDirty(Actor);
+    }
+}
+
+auto FEditorActorTagDisplayModule::OnObjectPropertyChanged(UObject *Object,
+                                                           FPropertyChangedEvent & /*PropertyChangedEvent*/) -> void
+{
+    AActor *Actor = Cast<AActor>(Object);
+    if (Actor == nullptr)
+    {
+        // コンポーネントの変更はバウンディングボックスに影響するため所有アクターを再評価する
+        if (const UActorComponent *Component = Cast<UActorComponent>(Object))
+        {
+            Actor = Component->GetOwner();
+        }
+    }
+    if (Actor == nullptr)
+    {
+        // オブジェクト参照の先の値を表示している場合があるため、値の文字列はすべて作り直す
+        ConfigMatcher.InvalidateAllValueTexts();
+        return;
+    }
+    ConfigMatcher.InvalidateValueText(Actor);
+
+    // 追跡外のアクターは、タグを持つかタグ以外を表示する設定のクラスの場合のみ表示対象になり得る
+    const FLabelContext *Context = FindLabelContext(Actor->GetWorld());
+    if ((Context != nullptr && Context->TrackedActors.Contains(Actor)) || MayShowLabel(Actor))
+    {
+        MarkActorDirty(Actor);
+    }
+}
+
+auto FEditorActorTagDisplayModule::OnObjectTransacted(UObject *Object, const FTransactionObjectEvent &TransactionEvent)
+    -> void
+{
+    AActor *Actor = Cast<AActor>(Object);
+    if (Actor == nullptr)
+    {
+        if (const UActorComponent *Component = Cast<UActorComponent>(Object))
+        {
+            Actor = Component->GetOwner();
+        }
+    }
+
+    // エディターでのコンポーネントの追加・削除はアクターとコンポーネントへのトランザクションとして確定する
+    // （コリジョンのないコンポーネントの登録・解除は他に通知がない）
+    if (TransactionEvent.GetEventType() == ETransactionObjectEventType::Finalized)
+    {
+        const FLabelContext *Context = Actor != nullptr ? FindLabelContext(Actor->GetWorld()) : nullptr;
+        if (Context != nullptr && Context->AnchorCache.Contains(Actor))
+        {
+            MarkActorDirty(Actor);
+        }
+        return;
+    }
+    if (TransactionEvent.GetEventType() != ETransactionObjectEventType::UndoRedo)
+    {
+        return;
+    }
+
+    // アンドゥ・リドゥではタグ・位置・生存状態のいずれも変わり得るため無条件に再評価する
+    if (Actor == nullptr)
+    {
+        ConfigMatcher.InvalidateAllValueTexts();
+        return;
+    }
+    ConfigMatcher.InvalidateValueText(Actor);
+    MarkActorDirty(Actor);
+}
+
+auto FEditorActorTagDisplayModule::OnComponentPhysicsStateChanged(UActorComponent *Component) -> void
+{
+    // コリジョンを持つコンポーネントの登録・解除を検出する
+    // 基準位置をキャッシュしているアクターのみ対象にする（レベル読み込み中は大量に通知される）
+    AActor *Actor = Component != nullptr ? Component->GetOwner() : nullptr;
+    const FLabelContext *Context = Actor != nullptr ? FindLabelContext(Actor->GetWorld()) : nullptr;
+    if (Context != nullptr && Context->AnchorCache.Contains(Actor))
+    {
+        MarkActorDirty(Actor);
+    }
+}
+
+auto FEditorActorTagDisplayModule::SetWorldOverride(UWorld *World) -> void
+{
+    if (WorldOverride.Get() == World)
+    {
+        return;
+    }
+
+    // 以前のワールドのラベルとプールはそのワールドと共に破棄されるため、先に手放す
+    RemoveAllLabelContexts();
+    WorldOverride = World;
+    bAreLabelWorldsDirty = true;
+}
+
+auto FEditorActorTagDisplayModule::ProcessActorsInWorld(FLabelContext &Context, UWorld *World,
+                                                        const UEditorActorTagDisplaySettings *Settings) -> void
+{
+    SCOPE_CYCLE_COUNTER(STAT_EditorActorTagDisplay_ProcessActorsInWorld);
+    TRACE_CPUPROFILER_EVENT_SCOPE(EditorActorTagDisplay::ProcessActorsInWorld);
+
+    // NOLINTNEXTLINE
+    check(World != nullptr);
+    // NOLINTNEXTLINE
+    check(Settings != nullptr);
+
+    const TArray<FActorClassTagDisplayConfig> &ClassConfigs = Settings->GetClassConfigs();
+    VisibleActorBuffer.Reset();
+    for (TActorIterator<AActor> It(World); It; ++It)
+    {
+        AActor *Actor = *It;
+        if (Actor == nullptr || !IsValid(Actor) || !ConfigMatcher.MayShowLabel(Actor, ClassConfigs))
+        {
+            continue;
+        }
+
+        if (ConfigMatcher.MatchActor(Actor, ClassConfigs) != INDEX_NONE)
+        {
+            VisibleActorBuffer.Add(Actor);
+        }
+    }
+
+    // 表示数の上限を超えた分は生成せず、既存のラベルも呼び出し元の掃き出しで解放する
+    if (FEditorActorTagDisplayModule::ShouldLimitVisibleLabels(Context, Settings))
+    {
+        LimitVisibleActors(Context, Settings);
+    }
+
+    for (AActor *Actor : VisibleActorBuffer)
+    {
+        // 新たに生成されるラベルは追加時に今回の世代が記録される（一致した設定はクラスのキャッシュから引く）
+        Context.Labels.MarkSeen(Actor);
+        SnapshotLabel(Context, Actor, FindMatchingConfigIndex(Actor->GetClass(), Settings), Settings);
+    }
+}
+
+auto FEditorActorTagDisplayModule::FindMatchingConfig(const AActor *Actor,
+                                                      const UEditorActorTagDisplaySettings *Settings)
+    -> const FActorClassTagDisplayConfig *
+{
+    // NOLINTNEXTLINE
+    check(Actor != nullptr);
+    // NOLINTNEXTLINE
+    check(Settings != nullptr);
+
+    const TArray<FActorClassTagDisplayConfig> &ClassConfigs = Settings->GetClassConfigs();
+    const int32 ConfigIndex = ConfigMatcher.MatchActor(Actor, ClassConfigs);
+    return ClassConfigs.IsValidIndex(ConfigIndex) ? &ClassConfigs[ConfigIndex] : nullptr;
+}
+
+auto FEditorActorTagDisplayModule::MayShowLabel(const AActor *Actor) -> bool
+{
+    const UEditorActorTagDisplaySettings *Settings = UEditorActorTagDisplaySettings::Get();
+    return Settings != nullptr && ConfigMatcher.MayShowLabel(Actor, Settings->GetClassConfigs());
+}
+
+auto FEditorActorTagDisplayModule::FindMatchingConfigIndex(const UClass *ActorClass,
+                                                           const UEditorActorTagDisplaySettings *Settings) -> int32
+{
+    // NOLINTNEXTLINE
+    check(Settings != nullptr);
+
+    return ConfigMatcher.FindConfigIndex(ActorClass, Settings->GetClassConfigs());
+}
+
+auto FEditorActorTagDisplayModule::RegisterClassCacheDelegates() -> void
+{
+    // ホットリロード・Live Codingでクラスが差し替えられた場合
+    ReloadCompleteDelegateHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda(
+        [this](EReloadCompleteReason /*Reason*/) -> void { InvalidateClassConfigCache(); });
+
+    // ブループリントの再コンパイルでクラス階層が変わった場合
+    if (GEditor != nullptr)
+    {
+        BlueprintCompiledDelegateHandle =
+            GEditor->OnBlueprintCompiled().AddLambda([this]() -> void { InvalidateClassConfigCache(); });
+    }
+}
+
+auto FEditorActorTagDisplayModule::UnregisterClassCacheDelegates() -> void
+{
+    FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteDelegateHandle);
+    if (GEditor != nullptr)
+    {
+        GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledDelegateHandle);
+    }
+
+    ReloadCompleteDelegateHandle.Reset();
+    BlueprintCompiledDelegateHandle.Reset();
+    ConfigMatcher.Reset();
+}
+
+auto FEditorActorTagDisplayModule::InvalidateClassConfigCache() -> void
+{
+    ConfigMatcher.Reset();
+
+    // 一致結果が変わり得るので、すべてのワールドで追跡中のアクターも含めて再評価する
+    for (auto &Pair : LabelContexts)
+    {
+        Pair.Value->AnchorCache.InvalidateAll();
+        Pair.Value->bNeedsFullSweep = true;
+    }
+}
+
+auto FEditorActorTagDisplayModule::CreateOrUpdateTextActor(FLabelContext &Context, AActor *Actor,
+                                                           const FActorClassTagDisplayConfig &Config,
+                                                           int32 SnapshotIndex) -> void
+{
+    SCOPE_CYCLE_COUNTER(STAT_EditorActorTagDisplay_CreateOrUpdateTextActor);
+    TRACE_CPUPROFILER_EVENT_SCOPE(EditorActorTagDisplay::CreateOrUpdateTextActor);
+
+    // NOLINTNEXTLINE
+    check(Actor != nullptr);
+
+    if (LabelSnapshot.GetNumLines(SnapshotIndex) == 0)
+    {
+        return;
+    }
+
+    int32 LabelHandle = INDEX_NONE;
+    if (Context.ActiveRenderMode == EEditorActorTagDisplayRenderMode::CanvasOverlay)
+    {
+        LabelHandle = Context.Labels.FindOrAdd(Actor);
+        UpdateOverlayLabelProperties(Context, LabelHandle, Config, Actor, SnapshotIndex);
+    }
+    else if (Context.ActiveRenderMode == EEditorActorTagDisplayRenderMode::Batched)
+    {
+        UEditorActorTagDisplayBatchComponent *BatchComponent = GetOrCreateBatchComponent(Context, Actor->GetWorld());
+        if (BatchComponent != nullptr)
+        {
+            LabelHandle = Context.Labels.FindOrAdd(Actor);
+            UpdateBatchedLabelProperties(Context, LabelHandle, *BatchComponent, Config, SnapshotIndex);
+        }
+    }
+    else
+    {
+        LabelHandle = GetOrCreateTextActor(Context, Actor);
+        if (LabelHandle != INDEX_NONE)
+        {
+            UpdateTextActorProperties(Context, LabelHandle, Config, SnapshotIndex);
+        }
+    }
+
+    // 向きの更新で参照する位置をテーブルに記録する
+    if (LabelHandle != INDEX_NONE)
+    {
+        Context.Labels.SetAnchor(LabelHandle, LabelSnapshot.GetTextPosition(SnapshotIndex));
+    }
+}
+
+auto FEditorActorTagDisplayModule::QuantizeVector(const FVector &Value, double Step) -> FIntVector
+{
+    return {FMath::RoundToInt32(Value.X / Step), FMath::RoundToInt32(Value.Y / Step),
+            FMath::RoundToInt32(Value.Z / Step)};
+}
+
+auto FEditorActorTagDisplayModule::GetOrCreateTextActor(FLabelContext &Context, AActor *Actor) -> int32
+{
+    SCOPE_CYCLE_COUNTER(STAT_EditorActorTagDisplay_GetOrCreateTextActor);
+    TRACE_CPUPROFILER_EVENT_SCOPE(EditorActorTagDisplay::GetOrCreateTextActor);
+
+    // NOLINTNEXTLINE
+    check(Actor != nullptr);
+
+    const int32 ExistingHandle = Context.Labels.Find(Actor);
+    if (ExistingHandle != INDEX_NONE && Context.Labels.GetEntry(ExistingHandle).TextActor.IsValid())
+    {
+        return ExistingHandle;
+    }
+
+    UWorld *World = Actor->GetWorld();
+    if (World == nullptr)
+    {
+        return INDEX_NONE;
+    }
+
+    // プールに空きがあれば再利用し、なければ新規に生成する
+    AEditorActorTagDisplayActor *TextActor = AcquirePooledTextActor(Context, World);
+    if (TextActor == nullptr)
+    {
+        // ラベルアクターは再利用されるため、名前は対象アクターに紐付けずエンジンに自動採番させる
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        SpawnParams.bHideFromSceneOutliner = true;
+        SpawnParams.ObjectFlags = RF_Transient;
+
+        TextActor = World->SpawnActor<AEditorActorTagDisplayActor>(SpawnParams);
+        if (TextActor == nullptr)
+        {
+            return INDEX_NONE;
+        }
+        INC_DWORD_STAT(STAT_EditorActorTagDisplay_Spawns);
+
+        SetupTextActor(TextActor);
+    }
+
+    // ラベルアクターを失ったエントリは、フィンガープリントも含めて作り直す
+    const int32 LabelHandle = Context.Labels.FindOrAdd(Actor);
+    FTextActorEntry &Entry = Context.Labels.GetEntry(LabelHandle);
+    Entry = FTextActorEntry();
+    Entry.TextActor = TextActor;
+    return LabelHandle;
+}
+
+auto FEditorActorTagDisplayModule::SetupTextActor(AEditorActorTagDisplayActor *TextActor) -> void
+{
+    // NOLINTNEXTLINE
+    check(TextActor != nullptr);
+
+    UTextRenderComponent *TextComponent = TextActor->GetTextRenderComponent();
+    if (TextComponent == nullptr)
+    {
+        return;
+    }
+
+    const UEditorActorTagDisplaySettings *Settings = UEditorActorTagDisplaySettings::Get();
+    // NOLINTNEXTLINE
+    check(Settings != nullptr);
+    const float TextSize = Settings->GetTextSize();
+
+    TextComponent->SetMobility(EComponentMobility::Movable);
+    TextComponent->SetHorizontalAlignment(EHTA_Center);
+    TextComponent->SetWorldSize(TextSize);
+    TextComponent->SetVisibility(true);
+
+    // プラグイン内のマテリアルを設定
+    SetTextMaterial(TextComponent);
+}
+
+auto FEditorActorTagDisplayModule::UpdateTextActorProperties(FLabelContext &Context, int32 LabelHandle,
+                                                             const FActorClassTagDisplayConfig &Config,
+                                                             int32 SnapshotIndex) -> void
+{
+    FTextActorEntry &Entry = Context.Labels.GetEntry(LabelHandle);
+    AEditorActorTagDisplayActor *TextActor = Entry.TextActor.Get();
+    if (TextActor == nullptr)
+    {
+        return;
+    }
+
+    UTextRenderComponent *TextComponent = TextActor->GetTextRenderComponent();
+    if (TextComponent == nullptr)
+    {
+        return;
+    }
+
+    // タグが変わった場合のみグリフメッシュを再構築する
+    const uint32 TagsHash = LabelSnapshot.GetTagsHash(SnapshotIndex);
+    if (!Entry.bIsFingerprintValid || Context.Labels.GetTextHash(LabelHandle) != TagsHash)
+    {
+        const FString &Text = LabelSnapshot.EnsureText(SnapshotIndex);
+        TextComponent->SetText(FText::FromString(Text));
+        Context.Labels.SetTextHash(LabelHandle, TagsHash);
+        Entry.NumGlyphs = Text.Len();
+        ++TextWriteCounter.Issued;
+        INC_DWORD_STAT(STAT_EditorActorTagDisplay_TextRebuilds);
+    }
+    else
+    {
+        ++TextWriteCounter.Skipped;
+    }
+
+    const FColor Color = Config.DisplayColor.ToFColor(true);
+    if (!Entry.bIsFingerprintValid || Entry.Color != Color)
+    {
+        TextComponent->SetTextRenderColor(Color);
+        Entry.Color = Color;
+        ++ColorWriteCounter.Issued;
+    }
+    else
+    {
+        ++ColorWriteCounter.Skipped;
+    }
+
+    const FVector &TextPosition = LabelSnapshot.GetTextPosition(SnapshotIndex);
+
+    const FIntVector QuantizedLocation =
+        FEditorActorTagDisplayModule::QuantizeVector(TextPosition, LocationQuantizeStep);
+    if (!Entry.bIsFingerprintValid || Entry.QuantizedLocation != QuantizedLocation)
+    {
+        TextActor->SetActorLocation(TextPosition);
+        Entry.QuantizedLocation = QuantizedLocation;
+        ++LocationWriteCounter.Issued;
+    }
+    else
+    {
+        ++LocationWriteCounter.Skipped;
+    }
+
+    UpdateTextActorRotation(Context, Entry, LabelSnapshot.GetTextRotation(SnapshotIndex));
+    Entry.bIsFingerprintValid = true;
+}
+
+auto FEditorActorTagDisplayModule::ComputeTextPosition(FLabelContext &Context, AActor *Actor,
+                                                       const FActorClassTagDisplayConfig &Config) -> FVector
+{
+    // NOLINTNEXTLINE
+    check(Actor != nullptr);
+
+    // 全走査モードではイベントで無効化できないため、キャッシュせず毎回計算する
+    const FVector TextPosition = Context.bIsTrackingActors
+                                     ? Context.AnchorCache.GetAnchor(Actor, Config)
+                                     : FEditorActorTagDisplayAnchorCache::ComputeAnchor(Actor, Config);
+
+    return TextPosition + Config.PositionOffset; // クラスごとの位置オフセットを適用
+}
+
+auto FEditorActorTagDisplayModule::GetEffectiveRenderMode(const UEditorActorTagDisplaySettings *Settings)
+    -> EEditorActorTagDisplayRenderMode
+{
+    // NOLINTNEXTLINE
+    check(Settings != nullptr);
+
+    // バッチ描画はTextRenderComponentと同じフォントのアトラスを直接参照するため、対応していないフォントでは使えない
+    const EEditorActorTagDisplayRenderMode RenderMode = Settings->GetRenderMode();
+    if (RenderMode == EEditorActorTagDisplayRenderMode::Batched &&
+        !UEditorActorTagDisplayBatchComponent::SupportsFont(GetDefault<UTextRenderComponent>()->Font))
+    {
+        return EEditorActorTagDisplayRenderMode::PerActor;
+    }
+    return RenderMode;
+}
+
+auto FEditorActorTagDisplayModule::GetOrCreateBatchComponent(FLabelContext &Context, UWorld *World)
+    -> UEditorActorTagDisplayBatchComponent *
+{
+    if (World == nullptr)
+    {
+        return nullptr;
+    }
+
+    if (Context.BatchActor.IsValid() && Context.BatchActor->GetWorld() == World)
+    {
+        return Context.BatchActor->GetBatchComponent();
+    }
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.Name = TEXT("TagDisplayBatchActor");
+    SpawnParams.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    SpawnParams.bHideFromSceneOutliner = true;
+    SpawnParams.ObjectFlags = RF_Transient;
+
+    auto *const NewBatchActor = World->SpawnActor<AEditorActorTagDisplayBatchActor>(SpawnParams);
+    if (NewBatchActor == nullptr || NewBatchActor->GetBatchComponent() == nullptr)
+    {
+        return nullptr;
+    }
+    INC_DWORD_STAT(STAT_EditorActorTagDisplay_Spawns);
+
+    if (Context.BatchActor.IsValid())
+    {
+        Context.BatchActor->Destroy();
+        INC_DWORD_STAT(STAT_EditorActorTagDisplay_Destroys);
+    }
+    Context.BatchActor = NewBatchActor;
+
+    UEditorActorTagDisplayBatchComponent *BatchComponent = NewBatchActor->GetBatchComponent();
+    const UEditorActorTagDisplaySettings *Settings = UEditorActorTagDisplaySettings::Get();
+    // NOLINTNEXTLINE
+    check(Settings != nullptr);
+    BatchComponent->SetTextSize(Settings->GetTextSize());
+    if (Context.bHasFrameCameraView)
+    {
+        BatchComponent->SetFacingRotation(Context.FrameCameraView.Rotation);
+    }
+
+    // バッチコンポーネントはフォントをバインドした専用のインスタンスを持つ
+    if (UMaterialInterface *TextMaterial = GetTextBaseMaterial())
+    {
+        BatchComponent->SetTextMaterial(TextMaterial);
+        if (UMaterialInstanceDynamic *DynamicMaterial = BatchComponent->GetTextMaterialInstance())
+        {
+            DynamicMaterial->SetScalarParameterValue(TEXT("OutlineWidth"), Settings->GetOutlineWidth());
+        }
+    }
+
+    // 以前のコンポーネントのラベルIDは無効なので、既存エントリを再登録させる
+    Context.Labels.ForEachLabel(
+        [&Context](int32 LabelHandle) -> void
+        {
+            FTextActorEntry &Entry = Context.Labels.GetEntry(LabelHandle);
+            Entry.BatchLabelId = INDEX_NONE;
+            Entry.bIsFingerprintValid = false;
+        });
+
+    return BatchComponent;
+}
+
+auto FEditorActorTagDisplayModule::UpdateBatchedLabelProperties(FLabelContext &Context, int32 LabelHandle,
+                                                                UEditorActorTagDisplayBatchComponent &BatchComponent,
+                                                                const FActorClassTagDisplayConfig &Config,
+                                                                int32 SnapshotIndex) -> void
+{
+    FTextActorEntry &Entry = Context.Labels.GetEntry(LabelHandle);
+    if (Entry.BatchLabelId == INDEX_NONE)
+    {
+        Entry.BatchLabelId = BatchComponent.AddLabel();
+        Entry.bIsFingerprintValid = false;
+    }
+
+    const uint32 TagsHash = LabelSnapshot.GetTagsHash(SnapshotIndex);
+    if (!Entry.bIsFingerprintValid || Context.Labels.GetTextHash(LabelHandle) != TagsHash)
+    {
+        // 同じ文字列のラベルが既にあれば、グリフ配置は作らずに共有する
+        if (BatchComponent.SetLabelText(Entry.BatchLabelId, LabelSnapshot.EnsureText(SnapshotIndex)))
+        {
+            INC_DWORD_STAT(STAT_EditorActorTagDisplay_TextRebuilds);
+        }
+        Context.Labels.SetTextHash(LabelHandle, TagsHash);
+        Entry.NumGlyphs = BatchComponent.GetLabelNumGlyphs(Entry.BatchLabelId);
+        ++TextWriteCounter.Issued;
+    }
+    else
+    {
+        ++TextWriteCounter.Skipped;
+    }
+
+    const FColor Color = Config.DisplayColor.ToFColor(true);
+    if (!Entry.bIsFingerprintValid || Entry.Color != Color)
+    {
+        BatchComponent.SetLabelColor(Entry.BatchLabelId, Color);
+        Entry.Color = Color;
+        ++ColorWriteCounter.Issued;
+    }
+    else
+    {
+        ++ColorWriteCounter.Skipped;
+    }
+
+    // 回転はバッチコンポーネントがカメラの回転でまとめて向けるため書き込まない
+    const FVector &TextPosition = LabelSnapshot.GetTextPosition(SnapshotIndex);
+    const FIntVector QuantizedLocation =
+        FEditorActorTagDisplayModule::QuantizeVector(TextPosition, LocationQuantizeStep);
+    if (!Entry.bIsFingerprintValid || Entry.QuantizedLocation != QuantizedLocation)
+    {
+        BatchComponent.SetLabelPosition(Entry.BatchLabelId, TextPosition);
+        Entry.QuantizedLocation = QuantizedLocation;
+        ++LocationWriteCounter.Issued;
+    }
+    else
+    {
+        ++LocationWriteCounter.Skipped;
+    }
+
+    Entry.bIsFingerprintValid = true;
+}
+
+auto FEditorActorTagDisplayModule::UpdateOverlayLabelProperties(FLabelContext &Context, int32 LabelHandle,
+                                                                const FActorClassTagDisplayConfig &Config,
+                                                                AActor *Actor, int32 SnapshotIndex) -> void
+{
+    // NOLINTNEXTLINE
+    check(Actor != nullptr);
+
+    FTextActorEntry &Entry = Context.Labels.GetEntry(LabelHandle);
+
+    if (Entry.BatchLabelId == INDEX_NONE || !Context.OverlayLabels.IsValidIndex(Entry.BatchLabelId))
+    {
+        Entry.BatchLabelId = Context.OverlayLabels.Add(FOverlayLabel());
+        Entry.bIsFingerprintValid = false;
+    }
+
+    FOverlayLabel &Label = Context.OverlayLabels[Entry.BatchLabelId];
+
+    // FTextへの変換と行数の計算はタグが変わった場合のみ行い、描画時には行わない
+    const uint32 TagsHash = LabelSnapshot.GetTagsHash(SnapshotIndex);
+    if (!Entry.bIsFingerprintValid || Context.Labels.GetTextHash(LabelHandle) != TagsHash)
+    {
+        Label.Text = FText::FromString(LabelSnapshot.EnsureText(SnapshotIndex));
+        Label.NumLines = FMath::Max(LabelSnapshot.GetNumLines(SnapshotIndex), 1);
+        Context.Labels.SetTextHash(LabelHandle, TagsHash);
+        ++TextWriteCounter.Issued;
+        INC_DWORD_STAT(STAT_EditorActorTagDisplay_TextRebuilds);
+    }
+    else
+    {
+        ++TextWriteCounter.Skipped;
+    }
+
+    const FColor Color = Config.DisplayColor.ToFColor(true);
+    if (!Entry.bIsFingerprintValid || Entry.Color != Color)
+    {
+        Label.Color = Color;
+        Entry.Color = Color;
+        ++ColorWriteCounter.Issued;
+    }
+    else
+    {
+        ++ColorWriteCounter.Skipped;
+    }
+
+    // 投影は描画時にビューごとに行うため、ワールド座標をそのまま保持する
+    const FVector &TextPosition = LabelSnapshot.GetTextPosition(SnapshotIndex);
+    const FIntVector QuantizedLocation =
+        FEditorActorTagDisplayModule::QuantizeVector(TextPosition, LocationQuantizeStep);
+    if (!Entry.bIsFingerprintValid || Entry.QuantizedLocation != QuantizedLocation)
+    {
+        Label.Position = TextPosition;
+        Entry.QuantizedLocation = QuantizedLocation;
+        ++LocationWriteCounter.Issued;
+    }
+    else
+    {
+        ++LocationWriteCounter.Skipped;
+    }
+
+    // 優先度は設定の変更に追従させるため毎回書き込む（書き込み数の集計対象外）
+    Label.Priority = FEditorActorTagDisplayModule::GetLabelPriority(Config);
+
+    Entry.bIsFingerprintValid = true;
+}
+
+auto FEditorActorTagDisplayModule::DrawCanvasOverlay(UCanvas *Canvas, APlayerController * /*PlayerController*/,
+                                                     bool bIsGameView) -> void
+{
+    SCOPE_CYCLE_COUNTER(STAT_EditorActorTagDisplay_DrawCanvasOverlay);
+    TRACE_CPUPROFILER_EVENT_SCOPE(EditorActorTagDisplay::DrawCanvasOverlay);
+
+    if (Canvas == nullptr || Canvas->SceneView == nullptr || GEngine == nullptr)
+    {
+        return;
+    }
+
+    // ゲームビュー表示のエディタービューポートには、エディター用の登録で描画済み
+    const FSceneView *View = Canvas->SceneView;
+    if (View->Family == nullptr || View->Family->Scene == nullptr ||
+        (bIsGameView && View->Family->EngineShowFlags.Editor))
+    {
+        return;
+    }
+
+    // ラベルのないワールド（アセットエディターのプレビューなど）のビューには描画しない
+    FLabelContext *Context = FindLabelContext(View->Family->Scene->GetWorld());
+    if (Context == nullptr || Context->ActiveRenderMode != EEditorActorTagDisplayRenderMode::CanvasOverlay ||
+        Context->OverlayLabels.IsEmpty())
+    {
+        return;
+    }
+
+    const UEditorActorTagDisplaySettings *Settings = UEditorActorTagDisplaySettings::Get();
+    if (Settings == nullptr)
+    {
+        return;
+    }
+
+    // ビューの行列は1回だけ取得し、全ラベルをまとめて投影する
+    const FMatrix ViewProjectionMatrix = View->ViewMatrices.GetViewProjectionMatrix();
+    const FVector ViewOrigin = View->ViewMatrices.GetViewOrigin();
+    // 最大距離は他の描画方式と同じく、カリングが有効な場合のみ適用する
+    const double MaxDistance = Settings->IsViewCullingEnabled() ? Settings->GetMaxLabelDistance() : 0.0;
+    const double MaxDistanceSquared = MaxDistance > 0.0 ? FMath::Square(MaxDistance) : TNumericLimits<double>::Max();
+    const double HalfWidth = Canvas->ClipX * 0.5;
+    const double HalfHeight = Canvas->ClipY * 0.5;
+
+    // 1行の高さが設定の文字サイズ（ワールド空間）と一致するよう、奥行きに応じてフォントを拡大縮小する
+    UFont *Font = GEngine->GetSmallFont();
+    const double LineHeight = Font != nullptr ? Font->GetMaxCharHeight() : 0.0;
+    const double PixelsPerUnitAtUnitDepth = View->ViewMatrices.GetProjectionMatrix().M[1][1] * HalfHeight;
+    const double TextSizeScale =
+        LineHeight > 0.0 ? Settings->GetTextSize() * PixelsPerUnitAtUnitDepth / LineHeight : 0.0;
+
+    // 直前のフレームに描画されなかったビューの結果は割り引きに使わないため破棄する
+    for (auto It = Context->OverlayViewStates.CreateIterator(); It; ++It)
+    {
+        if (It.Value().LastDrawnFrame + 1 < GFrameCounter)
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    // 割り引きはビューごとの描画結果で判定する（ビューの状態を持たないビューはキー0を共有する）
+    FOverlayViewState &ViewState = Context->OverlayViewStates.FindOrAdd(View->GetViewKey());
+
+    ProjectedOverlayLabels.Reset();
+    for (auto It = Context->OverlayLabels.CreateConstIterator(); It; ++It)
+    {
+        const FOverlayLabel &Label = *It;
+        const double DistanceSquared = FVector::DistSquared(Label.Position, ViewOrigin);
+        if (DistanceSquared > MaxDistanceSquared)
+        {
+            continue;
+        }
+
+        const FVector4 ClipPosition = ViewProjectionMatrix.TransformFVector4(FVector4(Label.Position, 1.0));
+        if (ClipPosition.W <= UE_SMALL_NUMBER)
+        {
+            continue; // カメラの後方
+        }
+
+        const double NdcX = ClipPosition.X / ClipPosition.W;
+        const double NdcY = ClipPosition.Y / ClipPosition.W;
+        if (FMath::Abs(NdcX) > OverlayScreenMargin || FMath::Abs(NdcY) > OverlayScreenMargin)
+        {
+            continue;
+        }
+
+        FProjectedOverlayLabel &Projected = ProjectedOverlayLabels.AddDefaulted_GetRef();
+        Projected.LabelId = It.GetIndex();
+        Projected.ScreenPosition = FVector2D(HalfWidth * (1.0 + NdcX), HalfHeight * (1.0 - NdcY));
+        Projected.TextScale = TextSizeScale / ClipPosition.W;
+
+        // このビューの直前のフレームに描画したラベルは距離を割り引き、上限付近でのちらつきを防ぐ
+        Projected.Score = FMath::Sqrt(DistanceSquared) / Label.Priority;
+        if (ViewState.DrawnLabels.IsValidIndex(It.GetIndex()) && ViewState.DrawnLabels[It.GetIndex()])
+        {
+            Projected.Score *= VisibleLabelHysteresisScale;
+        }
+    }
+
+    // 表示数の上限はビューごとに適用する
+    LimitProjectedOverlayLabels(Settings->GetMaxVisibleLabels());
+    ViewState.DrawnLabels.Init(false, Context->OverlayLabels.GetMaxIndex());
+    ViewState.LastDrawnFrame = GFrameCounter;
+    if (ProjectedOverlayLabels.IsEmpty())
+    {
+        return;
+    }
+
+    // 基準位置をラベルの下端中央とし、行数分だけ上に描画する
+    FCanvasTextItem TextItem(FVector2D::ZeroVector, FText::GetEmpty(), Font, FLinearColor::White);
+    TextItem.bCentreX = true;
+    TextItem.bOutlined = Settings->GetOutlineWidth() > 0.0F;
+    TextItem.OutlineColor = FLinearColor::Black;
+
+    for (const FProjectedOverlayLabel &Projected : ProjectedOverlayLabels)
+    {
+        const FOverlayLabel &Label = Context->OverlayLabels[Projected.LabelId];
+        ViewState.DrawnLabels[Projected.LabelId] = true;
+        TextItem.Scale = FVector2D(Projected.TextScale);
+        TextItem.Position =
+            Projected.ScreenPosition - FVector2D(0.0, LineHeight * Projected.TextScale * Label.NumLines);
+        TextItem.Text = Label.Text;
+        TextItem.SetColor(FLinearColor(Label.Color));
+        Canvas->DrawItem(TextItem);
+    }
+}
+
+auto FEditorActorTagDisplayModule::ReleaseTextActorEntry(FLabelContext &Context, FTextActorEntry &Entry) -> void
+{
+    if (AEditorActorTagDisplayActor *TextActor = Entry.TextActor.Get())
+    {
+        ReleaseTextActorToPool(Context, TextActor);
+    }
+    if (Entry.BatchLabelId != INDEX_NONE)
+    {
+        if (Context.ActiveRenderMode == EEditorActorTagDisplayRenderMode::CanvasOverlay)
+        {
+            if (Context.OverlayLabels.IsValidIndex(Entry.BatchLabelId))
+            {
+                Context.OverlayLabels.RemoveAt(Entry.BatchLabelId);
+            }
+
+            // 再利用されるIDが、以前のラベルの描画結果で割り引かれないようにする
+            for (auto &Pair : Context.OverlayViewStates)
+            {
+                if (Pair.Value.DrawnLabels.IsValidIndex(Entry.BatchLabelId))
+                {
+                    Pair.Value.DrawnLabels[Entry.BatchLabelId] = false;
+                }
+            }
+        }
+        else if (Context.BatchActor.IsValid())
+        {
+            Context.BatchActor->GetBatchComponent()->RemoveLabel(Entry.BatchLabelId);
+        }
+    }
+
+    Entry.TextActor.Reset();
+    Entry.BatchLabelId = INDEX_NONE;
+}
+
+auto FEditorActorTagDisplayModule::AcquirePooledTextActor(FLabelContext &Context, UWorld *World)
+    -> AEditorActorTagDisplayActor *
+{
+    // NOLINTNEXTLINE
+    check(World != nullptr);
+
+    // 最後に戻されたものから再利用し、古いものほど猶予時間切れで破棄されやすくする
+    while (!Context.TextActorPool.IsEmpty())
+    {
+        AEditorActorTagDisplayActor *TextActor = Context.TextActorPool.Pop(EAllowShrinking::No).TextActor.Get();
+        if (TextActor == nullptr)
+        {
+            continue;
+        }
+
+        // 別のワールドのアクターは再利用できない
+        if (TextActor->GetWorld() != World)
+        {
+            TextActor->Destroy();
+            INC_DWORD_STAT(STAT_EditorActorTagDisplay_Destroys);
+            continue;
+        }
+
+        // プール中の文字サイズの変更は反映されていないため、現在の設定を適用し直す
+        // （アウトラインは共有マテリアルインスタンスで反映済み）
+        if (UTextRenderComponent *TextComponent = TextActor->GetTextRenderComponent())
+        {
+            if (const UEditorActorTagDisplaySettings *Settings = UEditorActorTagDisplaySettings::Get())
+            {
+                TextComponent->SetWorldSize(Settings->GetTextSize());
+            }
+            TextComponent->SetVisibility(true);
+        }
+        return TextActor;
+    }
+
+    return nullptr;
+}
+
+auto FEditorActorTagDisplayModule::ReleaseTextActorToPool(FLabelContext &Context,
+                                                          AEditorActorTagDisplayActor *TextActor) -> void
+{
+    // NOLINTNEXTLINE
+    check(TextActor != nullptr);
+
+    const UEditorActorTagDisplaySettings *Settings = UEditorActorTagDisplaySettings::Get();
+    if (Settings == nullptr || Context.TextActorPool.Num() >= Settings->GetMaxPooledLabels())
+    {
+        TextActor->Destroy();
+        INC_DWORD_STAT(STAT_EditorActorTagDisplay_Destroys);
+        return;
+    }
+
+    if (UTextRenderComponent *TextComponent = TextActor->GetTextRenderComponent())
+    {
+        TextComponent->SetVisibility(false);
     }
 
-    CleanupTextActors();
+    FPooledTextActor &PooledTextActor = Context.TextActorPool.AddDefaulted_GetRef();
+    PooledTextActor.TextActor = TextActor;
+    PooledTextActor.ReleaseTime = FPlatformTime::Seconds();
 }
 
-auto FEditorActorTagDisplayModule::UpdateTextActors() -> void
+auto FEditorActorTagDisplayModule::TrimTextActorPool(FLabelContext &Context) -> void
 {
-    const UEditorActorTagDisplaySettings *Settings = UEditorActorTagDisplaySettings::Get();
-    if (Settings == nullptr || !Settings->IsTagDisplayEnabled())
+    if (Context.TextActorPool.IsEmpty())
     {
-        CleanupTextActors();
         return;
     }
 
-    UWorld *World = FEditorActorTagDisplayModule::GetEditorWorld();
-    if (World == nullptr)
+    const UEditorActorTagDisplaySettings *Settings = UEditorActorTagDisplaySettings::Get();
+    if (Settings == nullptr)
     {
-        CleanupTextActors();
+        EmptyTextActorPool(Context);
         return;
     }
 
-    TSet<TWeakObjectPtr<AActor>> ProcessedActors;
-    ProcessActorsInWorld(World, Settings, ProcessedActors);
-    RemoveUnusedTextActors(ProcessedActors);
-}
+    // プールは戻された順に並んでいるため、先頭から期限切れと上限超過の分だけ破棄する
+    const double ExpireTime = FPlatformTime::Seconds() - Settings->GetPooledLabelGracePeriod();
+    const int32 NumOverLimit = FMath::Max(Context.TextActorPool.Num() - Settings->GetMaxPooledLabels(), 0);
 
-auto FEditorActorTagDisplayModule::GetEditorWorld() -> UWorld *
-{
-    if (GEditor == nullptr)
+    int32 NumToDestroy = 0;
+    while (NumToDestroy < Context.TextActorPool.Num() &&
+           (NumToDestroy < NumOverLimit || Context.TextActorPool[NumToDestroy].ReleaseTime <= ExpireTime))
     {
-        return nullptr;
+        if (AEditorActorTagDisplayActor *TextActor = Context.TextActorPool[NumToDestroy].TextActor.Get())
+        {
+            TextActor->Destroy();
+            INC_DWORD_STAT(STAT_EditorActorTagDisplay_Destroys);
+        }
+        ++NumToDestroy;
+    }
+
+    if (NumToDestroy > 0)
+    {
+        Context.TextActorPool.RemoveAt(0, NumToDestroy, EAllowShrinking::No);
     }
-    return GEditor->GetEditorWorldContext().World();
 }
 
-auto FEditorActorTagDisplayModule::ProcessActorsInWorld(UWorld *World, const UEditorActorTagDisplaySettings *Settings,
-                                                        TSet<TWeakObjectPtr<AActor>> &ProcessedActors) -> void
+auto FEditorActorTagDisplayModule::EmptyTextActorPool(FLabelContext &Context) -> void
 {
-    // NOLINTNEXTLINE
-    check(World != nullptr);
-    // NOLINTNEXTLINE
-    check(Settings != nullptr);
-
-    for (TActorIterator<AActor> It(World); It; ++It)
+    for (const FPooledTextActor &PooledTextActor : Context.TextActorPool)
     {
-        AActor *Actor = *It;
-        if (Actor == nullptr || !IsValid(Actor) || Actor->Tags.IsEmpty())
+        if (AEditorActorTagDisplayActor *TextActor = PooledTextActor.TextActor.Get())
         {
-            continue;
+            TextActor->Destroy();
+            INC_DWORD_STAT(STAT_EditorActorTagDisplay_Destroys);
         }
-
-        ProcessActorIfMatched(Actor, Settings, ProcessedActors);
     }
+    Context.TextActorPool.Empty();
 }
 
-auto FEditorActorTagDisplayModule::ProcessActorIfMatched(AActor *Actor, const UEditorActorTagDisplaySettings *Settings,
-                                                         TSet<TWeakObjectPtr<AActor>> &ProcessedActors) -> void
+auto FEditorActorTagDisplayModule::GetCameraView(UWorld *World, FMinimalViewInfo &OutViewInfo) -> bool
 {
     // NOLINTNEXTLINE
-    check(Actor != nullptr);
-    // NOLINTNEXTLINE
-    check(Settings != nullptr);
+    check(World != nullptr);
 
-    for (const FActorClassTagDisplayConfig &Config : Settings->GetClassConfigs())
+    // PIEのワールドでは、そのワールドのローカルプレイヤーのカメラを使う
+    if (World->IsGameWorld() && GEngine != nullptr)
     {
-        if (Config.ActorClass.IsValid() && Actor->IsA(Config.ActorClass.Get()))
+        const APlayerController *PlayerController = GEngine->GetFirstLocalPlayerController(World);
+        if (PlayerController != nullptr && PlayerController->PlayerCameraManager != nullptr)
         {
-            ProcessedActors.Add(Actor);
-            CreateOrUpdateTextActor(Actor, Config);
-            break;
+            OutViewInfo = PlayerController->PlayerCameraManager->GetCameraCacheView();
+            return true;
         }
     }
-}
 
-auto FEditorActorTagDisplayModule::CreateOrUpdateTextActor(AActor *Actor, const FActorClassTagDisplayConfig &Config)
-    -> void
-{
-    // NOLINTNEXTLINE
-    check(Actor != nullptr);
+    if (GEditor == nullptr)
+    {
+        return false;
+    }
 
-    FString CombinedTags = FEditorActorTagDisplayModule::CombineActorTags(Actor);
-    if (CombinedTags.IsEmpty())
+    // エディターワールド（とSimulate In Editor）では、そのワールドを表示しているビューポートのカメラを使う。
+    // アクティブなビューポートを優先し、なければ最初に見つかった表示中のビューポートを使う
+    const FViewport *ActiveViewport = GEditor->GetActiveViewport();
+    const FEditorViewportClient *FallbackViewportClient = nullptr;
+    for (const FEditorViewportClient *ViewportClient : GEditor->GetAllViewportClients())
     {
-        return;
+        if (ViewportClient == nullptr || ViewportClient->GetWorld() != World || ViewportClient->Viewport == nullptr)
+        {
+            continue;
+        }
+
+        if (ViewportClient->Viewport == ActiveViewport)
+        {
+            FEditorActorTagDisplayModule::GetViewInfoFromViewportClient(*ViewportClient, OutViewInfo);
+            return true;
+        }
+        if (FallbackViewportClient == nullptr && ViewportClient->IsVisible())
+        {
+            FallbackViewportClient = ViewportClient;
+        }
     }
 
-    AEditorActorTagDisplayActor *TextActor = GetOrCreateTextActor(Actor);
-    if (TextActor == nullptr)
+    if (FallbackViewportClient != nullptr)
     {
-        return;
+        FEditorActorTagDisplayModule::GetViewInfoFromViewportClient(*FallbackViewportClient, OutViewInfo);
+        return true;
     }
 
-    FEditorActorTagDisplayModule::UpdateTextActorProperties(TextActor, CombinedTags, Config, Actor);
+    return false;
 }
 
-auto FEditorActorTagDisplayModule::CombineActorTags(AActor *Actor) -> FString
+auto FEditorActorTagDisplayModule::GetViewInfoFromViewportClient(const FEditorViewportClient &ViewportClient,
+                                                                 FMinimalViewInfo &OutViewInfo) -> void
 {
-    // NOLINTNEXTLINE
-    check(Actor != nullptr);
+    const FIntPoint ViewportSize = ViewportClient.Viewport->GetSizeXY();
+
+    OutViewInfo = FMinimalViewInfo();
+    OutViewInfo.Location = ViewportClient.GetViewLocation();
+    OutViewInfo.Rotation = ViewportClient.GetViewRotation();
+    OutViewInfo.FOV = ViewportClient.ViewFOV;
+    OutViewInfo.AspectRatio = ViewportSize.Y > 0 ? static_cast<float>(ViewportSize.X) / ViewportSize.Y : 1.0F;
+    OutViewInfo.ProjectionMode =
+        ViewportClient.IsPerspective() ? ECameraProjectionMode::Perspective : ECameraProjectionMode::Orthographic;
+}
 
-    TArray<FString> TagStrings;
-    for (const FName &Tag : Actor->Tags)
+auto FEditorActorTagDisplayModule::ComputeViewFrustum(const FMinimalViewInfo &ViewInfo, FConvexVolume &OutFrustum)
+    -> bool
+{
+    // 平行投影ビューでは距離の概念が異なるため、カリングを行わない
+    if (ViewInfo.ProjectionMode != ECameraProjectionMode::Perspective)
     {
-        TagStrings.Add(Tag.ToString());
+        return false;
     }
-    return FString::Join(TagStrings, TEXT("\n"));
+
+    FMatrix ViewMatrix;
+    FMatrix ProjectionMatrix;
+    FMatrix ViewProjectionMatrix;
+    UGameplayStatics::GetViewProjectionMatrix(ViewInfo, ViewMatrix, ProjectionMatrix, ViewProjectionMatrix);
+    GetViewFrustumBounds(OutFrustum, ViewProjectionMatrix, false);
+    return true;
 }
 
-auto FEditorActorTagDisplayModule::GetOrCreateTextActor(AActor *Actor) -> AEditorActorTagDisplayActor *
+auto FEditorActorTagDisplayModule::MaterializeVisibleLabels(FLabelContext &Context,
+                                                            const UEditorActorTagDisplaySettings *Settings,
+                                                            const FConvexVolume *ViewFrustum) -> void
 {
+    SCOPE_CYCLE_COUNTER(STAT_EditorActorTagDisplay_MaterializeVisibleLabels);
+    TRACE_CPUPROFILER_EVENT_SCOPE(EditorActorTagDisplay::MaterializeVisibleLabels);
+
     // NOLINTNEXTLINE
-    check(Actor != nullptr);
+    check(Settings != nullptr);
 
-    TWeakObjectPtr<AEditorActorTagDisplayActor> *ExistingActorPtr = TextActorMap.Find(Actor);
-    if (ExistingActorPtr != nullptr && ExistingActorPtr->IsValid())
+    // カリングしない場合は、追跡中の全アクターを表示数の上限の候補にする
+    VisibleActorBuffer.Reset();
+    if (ViewFrustum != nullptr)
     {
-        return ExistingActorPtr->Get();
+        Context.SpatialIndex.QueryView(*ViewFrustum, Context.FrameCameraLocation, Settings->GetMaxLabelDistance(),
+                                       Settings->GetTextSize(), VisibleActorBuffer);
     }
-
-    UWorld *World = Actor->GetWorld();
-    if (World == nullptr)
+    else
     {
-        return nullptr;
+        Context.SpatialIndex.GatherAll(VisibleActorBuffer);
     }
 
-    FActorSpawnParameters SpawnParams;
-    SpawnParams.Name = FName(*FString::Printf(TEXT("TagDisplayActor_%s"), *Actor->GetName()));
-    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-    SpawnParams.bHideFromSceneOutliner = true;
-    SpawnParams.ObjectFlags = RF_Transient;
+    // 表示数の上限を超えた分は生成せず、既存のラベルも下の掃き出しで解放する
+    if (FEditorActorTagDisplayModule::ShouldLimitVisibleLabels(Context, Settings))
+    {
+        LimitVisibleActors(Context, Settings);
+    }
 
-    auto *const TextActor = World->SpawnActor<AEditorActorTagDisplayActor>(SpawnParams);
-    if (TextActor == nullptr)
+    // 可視になったアクターのラベル生成を予約し、既存のラベルは変更時にProcessDirtyActorsで更新される
+    Context.Labels.BeginPass();
+    const uint32 VisibleGeneration = Context.Labels.GetGeneration();
+    for (AActor *Actor : VisibleActorBuffer)
     {
-        return nullptr;
+        if (!Context.Labels.MarkSeen(Actor))
+        {
+            FPendingLabelWork &Work = Context.PendingLabelWork.FindOrAdd(Actor);
+            Work.bCreate = true;
+            Work.VisibleGeneration = VisibleGeneration;
+        }
     }
 
-    FEditorActorTagDisplayModule::SetupTextActor(TextActor);
-    TextActorMap.Add(Actor, TextActor);
-    return TextActor;
+    // 視界から外れたラベルはプールに戻す
+    RemoveUnusedTextActors(Context);
 }
 
-auto FEditorActorTagDisplayModule::SetupTextActor(AEditorActorTagDisplayActor *TextActor) -> void
+auto FEditorActorTagDisplayModule::ShouldLimitVisibleLabels(FLabelContext &Context,
+                                                            const UEditorActorTagDisplaySettings *Settings) -> bool
 {
     // NOLINTNEXTLINE
-    check(TextActor != nullptr);
+    check(Settings != nullptr);
 
-    UTextRenderComponent *TextComponent = TextActor->GetTextRenderComponent();
-    if (TextComponent == nullptr)
+    // キャンバス描画では、描画時にビューごとに適用する
+    if (Settings->GetMaxVisibleLabels() <= 0 ||
+        Context.ActiveRenderMode == EEditorActorTagDisplayRenderMode::CanvasOverlay)
     {
-        return;
+        return false;
+    }
+    if (Context.bHasFrameCameraView)
+    {
+        return true;
     }
 
-    const UEditorActorTagDisplaySettings *Settings = UEditorActorTagDisplaySettings::Get();
-    // NOLINTNEXTLINE
-    check(Settings != nullptr);
-    const float TextSize = Settings->GetTextSize();
-
-    TextComponent->SetMobility(EComponentMobility::Movable);
-    TextComponent->SetHorizontalAlignment(EHTA_Center);
-    TextComponent->SetWorldSize(TextSize);
-    TextComponent->SetVisibility(true);
-
-    // プラグイン内のマテリアルを設定
-    FEditorActorTagDisplayModule::SetTextMaterial(TextComponent);
+    // 順位付けの基準になるカメラがないワールド（ベンチマーク用のワールドなど）では適用しない
+    if (!Context.bHasLoggedUnlimitedLabels)
+    {
+        const UWorld *World = Context.World.Get();
+        // NOLINTNEXTLINE
+        UE_LOG(LogEditorActorTagDisplay, Log, TEXT("Max Visible Labels is not applied to %s because it has no camera"),
+               World != nullptr ? *World->GetName() : TEXT("None"));
+        Context.bHasLoggedUnlimitedLabels = true;
+    }
+    return false;
 }
 
-auto FEditorActorTagDisplayModule::UpdateTextActorProperties(AEditorActorTagDisplayActor *TextActor,
-                                                             const FString &CombinedTags,
-                                                             const FActorClassTagDisplayConfig &Config, AActor *Actor)
-    -> void
+auto FEditorActorTagDisplayModule::LimitVisibleActors(FLabelContext &Context,
+                                                      const UEditorActorTagDisplaySettings *Settings) -> void
 {
     // NOLINTNEXTLINE
-    check(TextActor != nullptr);
-    // NOLINTNEXTLINE
-    check(Actor != nullptr);
+    check(Settings != nullptr);
 
-    UTextRenderComponent *TextComponent = TextActor->GetTextRenderComponent();
-    if (TextComponent == nullptr)
+    const int32 MaxVisibleLabels = Settings->GetMaxVisibleLabels();
+    if (MaxVisibleLabels <= 0 || VisibleActorBuffer.Num() <= MaxVisibleLabels)
     {
         return;
     }
 
-    TextComponent->SetText(FText::FromString(CombinedTags));
-    TextComponent->SetTextRenderColor(Config.DisplayColor.ToFColor(true));
-
-    FVector TextPosition = Actor->GetActorLocation();
-
-    const FBox ComponentsBounds = Actor->GetComponentsBoundingBox(false); // コリジョンコンポーネントのみ
-    if (ComponentsBounds.IsValid != 0U)
+    // 全体を並べ替えず、上限数の最大ヒープで近いもの（優先度で重み付け）だけを残す
+    // 距離はカリングやキャンバス描画と同じくラベルの表示位置（基準位置とクラスの位置オフセット）で測る
+    // 既にラベルがあるアクターは距離を割り引き、境界付近で生成と解放を繰り返さないようにする
+    const TArray<FActorClassTagDisplayConfig> &ClassConfigs = Settings->GetClassConfigs();
+    RankedLabelBuffer.Reset();
+    for (int32 Index = 0; Index < VisibleActorBuffer.Num(); ++Index)
     {
-        FVector BoundingCenter;
-        FVector BoundingExtents;
-        ComponentsBounds.GetCenterAndExtents(BoundingCenter, BoundingExtents);
+        AActor *Actor = VisibleActorBuffer[Index];
+        const int32 ConfigIndex = FindMatchingConfigIndex(Actor->GetClass(), Settings);
+        const FActorClassTagDisplayConfig *Config =
+            ClassConfigs.IsValidIndex(ConfigIndex) ? &ClassConfigs[ConfigIndex] : nullptr;
+        const double Priority = Config != nullptr ? FEditorActorTagDisplayModule::GetLabelPriority(*Config) : 1.0;
+        const FVector TextPosition =
+            Config != nullptr ? ComputeTextPosition(Context, Actor, *Config) : Actor->GetActorLocation();
+
+        FRankedLabel Label;
+        Label.Index = Index;
+        Label.Score = FVector::Dist(TextPosition, Context.FrameCameraLocation) / Priority;
+        if (Context.Labels.Contains(Actor))
+        {
+            Label.Score *= VisibleLabelHysteresisScale;
+        }
+        FEditorActorTagDisplayModule::PushRankedLabel(RankedLabelBuffer, Label, MaxVisibleLabels);
+    }
 
-        const auto HalfHeight = static_cast<float>(FVector::DotProduct(BoundingExtents, FVector::UpVector));
-        TextPosition = BoundingCenter + FVector::UpVector * HalfHeight;
+    // 選ばれたアクターを元の並び順のまま前に詰める
+    RankedLabelBuffer.Sort([](const FRankedLabel &A, const FRankedLabel &B) -> bool { return A.Index < B.Index; });
+    for (int32 Rank = 0; Rank < RankedLabelBuffer.Num(); ++Rank)
+    {
+        VisibleActorBuffer[Rank] = VisibleActorBuffer[RankedLabelBuffer[Rank].Index];
     }
-    else
+    VisibleActorBuffer.SetNum(RankedLabelBuffer.Num(), EAllowShrinking::No);
+}
+
+auto FEditorActorTagDisplayModule::LimitProjectedOverlayLabels(int32 MaxVisibleLabels) -> void
+{
+    if (MaxVisibleLabels <= 0 || ProjectedOverlayLabels.Num() <= MaxVisibleLabels)
     {
-        // コリジョンコンポーネントがない場合は、アクターの原点位置を使用
-        TextPosition = Actor->GetActorLocation();
+        return;
     }
 
-    TextPosition += Config.PositionOffset; // クラスごとの位置オフセットを適用
-    TextActor->SetActorLocation(TextPosition);
+    RankedLabelBuffer.Reset();
+    for (int32 Index = 0; Index < ProjectedOverlayLabels.Num(); ++Index)
+    {
+        FRankedLabel Label;
+        Label.Index = Index;
+        Label.Score = ProjectedOverlayLabels[Index].Score;
+        FEditorActorTagDisplayModule::PushRankedLabel(RankedLabelBuffer, Label, MaxVisibleLabels);
+    }
 
-    FEditorActorTagDisplayModule::UpdateTextActorRotation(TextActor, TextPosition);
+    RankedLabelBuffer.Sort([](const FRankedLabel &A, const FRankedLabel &B) -> bool { return A.Index < B.Index; });
+    for (int32 Rank = 0; Rank < RankedLabelBuffer.Num(); ++Rank)
+    {
+        ProjectedOverlayLabels[Rank] = ProjectedOverlayLabels[RankedLabelBuffer[Rank].Index];
+    }
+    ProjectedOverlayLabels.SetNum(RankedLabelBuffer.Num(), EAllowShrinking::No);
 }
 
-auto FEditorActorTagDisplayModule::GetCameraLocation() -> FVector
+auto FEditorActorTagDisplayModule::PushRankedLabel(TArray<FRankedLabel> &RankedLabels, const FRankedLabel &Label,
+                                                   int32 MaxLabels) -> void
 {
-    // PIE実行中かどうかを確認
-    if (GEditor != nullptr && GEditor->IsPlaySessionInProgress())
+    // 先頭が最も値の大きい（優先度の低い）候補になる最大ヒープで、上限数だけを保持する
+    const auto ByDescendingScore = [](const FRankedLabel &A, const FRankedLabel &B) -> bool
+    { return A.Score > B.Score; };
+
+    if (RankedLabels.Num() < MaxLabels)
     {
-        // PIE実行中はゲームのカメラ位置を取得
-        UWorld *PIEWorld =
-            (GEditor->GetPIEWorldContext() != nullptr) ? GEditor->GetPIEWorldContext()->World() : nullptr;
-        if (PIEWorld != nullptr)
-        {
-            // プレイヤーコントローラーからカメラ位置を取得
-            for (FConstPlayerControllerIterator Iterator = PIEWorld->GetPlayerControllerIterator(); Iterator;
-                 ++Iterator)
-            {
-                APlayerController *PlayerController = Iterator->Get();
-                if (PlayerController != nullptr && PlayerController->PlayerCameraManager != nullptr)
-                {
-                    return PlayerController->PlayerCameraManager->GetCameraLocation();
-                }
-            }
-        }
+        RankedLabels.HeapPush(Label, ByDescendingScore);
+        return;
     }
 
-    // エディター実行中はエディタービューポートのカメラ位置を取得
-    if (GEditor != nullptr && GEditor->GetActiveViewport() != nullptr)
+    if (Label.Score < RankedLabels.HeapTop().Score)
     {
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
-        const auto *const ViewportClient =
-            static_cast<FEditorViewportClient *>(GEditor->GetActiveViewport()->GetClient());
-        if (ViewportClient != nullptr)
-        {
-            return ViewportClient->GetViewLocation();
-        }
+        RankedLabels.HeapPopDiscard(ByDescendingScore, EAllowShrinking::No);
+        RankedLabels.HeapPush(Label, ByDescendingScore);
     }
+}
 
-    return FVector::ZeroVector;
+auto FEditorActorTagDisplayModule::GetLabelPriority(const FActorClassTagDisplayConfig &Config) -> double
+{
+    return FMath::Max(static_cast<double>(Config.LabelPriority), MinLabelPriority);
 }
 
-auto FEditorActorTagDisplayModule::UpdateTextActorRotation(AEditorActorTagDisplayActor *TextActor,
-                                                           const FVector &TextPosition) -> void
+auto FEditorActorTagDisplayModule::UpdateTextActorRotation(FLabelContext &Context, FTextActorEntry &Entry,
+                                                           const FRotator &LookAtRotation) -> void
 {
-    // NOLINTNEXTLINE
-    check(TextActor != nullptr);
+    // マテリアルでカメラに向けている場合、ラベルの向きは固定のまま
+    AEditorActorTagDisplayActor *TextActor = Entry.TextActor.Get();
+    if (TextActor == nullptr || bIsMaterialBillboardActive)
+    {
+        return;
+    }
+
+    if (Context.FrameCameraLocation.IsZero())
+    {
+        return;
+    }
 
-    FVector CameraLocation = FEditorActorTagDisplayModule::GetCameraLocation();
-    if (CameraLocation.IsZero())
+    const FIntVector QuantizedRotation = FEditorActorTagDisplayModule::QuantizeVector(
+        FVector(LookAtRotation.Pitch, LookAtRotation.Yaw, LookAtRotation.Roll), RotationQuantizeStep);
+    if (Entry.bIsFingerprintValid && Entry.QuantizedRotation == QuantizedRotation)
     {
+        ++RotationWriteCounter.Skipped;
         return;
     }
 
-    FVector DirectionToCamera = (CameraLocation - TextPosition).GetSafeNormal();
-    FRotator LookAtRotation = DirectionToCamera.Rotation();
     TextActor->SetActorRotation(LookAtRotation);
+    Entry.QuantizedRotation = QuantizedRotation;
+    ++RotationWriteCounter.Issued;
 }
 
-auto FEditorActorTagDisplayModule::RemoveUnusedTextActors(const TSet<TWeakObjectPtr<AActor>> &ProcessedActors) -> void
+auto FEditorActorTagDisplayModule::RemoveUnusedTextActors(FLabelContext &Context) -> void
 {
-    TArray<TWeakObjectPtr<AActor>> ToRemove;
+    SCOPE_CYCLE_COUNTER(STAT_EditorActorTagDisplay_RemoveUnusedTextActors);
+    TRACE_CPUPROFILER_EVENT_SCOPE(EditorActorTagDisplay::RemoveUnusedTextActors);
 
-    for (auto &Pair : TextActorMap)
-    {
-        if (!Pair.Key.IsValid() || !ProcessedActors.Contains(Pair.Key))
+    // 今回のパスで見つからなかった（破棄されたアクターを含む）ラベルを、1回の線形走査で取り除く
+    Context.Labels.SweepUnseen([this, &Context](int32 LabelHandle) -> void
+                               { ReleaseTextActorEntry(Context, Context.Labels.GetEntry(LabelHandle)); });
+}
+
+auto FEditorActorTagDisplayModule::CleanupTextActors(FLabelContext &Context) -> void
+{
+    // 表示の切り替えで生成と破棄を繰り返さないよう、ラベルアクターはプールに戻す
+    Context.Labels.ForEachLabel(
+        [this, &Context](int32 LabelHandle) -> void
         {
-            if (Pair.Value.IsValid())
+            if (AEditorActorTagDisplayActor *TextActor = Context.Labels.GetEntry(LabelHandle).TextActor.Get())
             {
-                Pair.Value->Destroy();
+                ReleaseTextActorToPool(Context, TextActor);
             }
-            ToRemove.Add(Pair.Key);
-        }
-    }
+        });
+    Context.Labels.Reset();
 
-    for (const auto &Key : ToRemove)
+    if (Context.BatchActor.IsValid())
     {
-        TextActorMap.Remove(Key);
+        Context.BatchActor->Destroy();
+        INC_DWORD_STAT(STAT_EditorActorTagDisplay_Destroys);
     }
-}
+    Context.BatchActor.Reset();
 
-auto FEditorActorTagDisplayModule::CleanupTextActors() -> void
-{
-    for (auto &Pair : TextActorMap)
-    {
-        if (Pair.Value.IsValid())
-        {
-            Pair.Value->Destroy();
-        }
-    }
-    TextActorMap.Empty();
+    Context.OverlayLabels.Empty();
+    Context.OverlayViewStates.Empty();
+
+    // ラベルを破棄したので、次回有効化時にワールドを再走査する
+    ResetActorTracking(Context);
 }
 
 auto FEditorActorTagDisplayModule::AddViewportShowFlagExtension() -> void
@@ -413,41 +2518,157 @@ auto FEditorActorTagDisplayModule::SetTextMaterial(UTextRenderComponent *TextCom
     // NOLINTNEXTLINE
     check(TextComponent != nullptr);
 
-    const FSoftObjectPath MaterialPath(TEXT_MATERIAL_PATH);
-    UMaterialInterface *TextMaterial = Cast<UMaterialInterface>(MaterialPath.TryLoad());
-
+    UMaterialInterface *TextMaterial = GetOrCreateSharedTextMaterial();
     if (TextMaterial != nullptr)
     {
-        ApplyMaterial(TextComponent, TextMaterial);
-        return;
+        TextComponent->SetTextMaterial(TextMaterial);
     }
-
-    // NOLINTNEXTLINE
-    UE_LOG(LogEditorActorTagDisplay, Error, TEXT("Failed to load text material from %s"), TEXT_MATERIAL_PATH);
 }
 
-auto FEditorActorTagDisplayModule::ApplyMaterial(UTextRenderComponent *TextComponent, UMaterialInterface *TextMaterial)
-    -> void
+auto FEditorActorTagDisplayModule::RequestTextMaterials() -> void
 {
+    if (TextMaterialLoadHandle.IsValid())
+    {
+        TextMaterialLoadHandle->CancelHandle();
+        TextMaterialLoadHandle.Reset();
+    }
+    bAreTextMaterialsLoaded = false;
+
+    const UEditorActorTagDisplaySettings *Settings = UEditorActorTagDisplaySettings::Get();
     // NOLINTNEXTLINE
-    check(TextComponent != nullptr);
-    // NOLINTNEXTLINE
-    check(TextMaterial != nullptr);
+    check(Settings != nullptr);
 
-    UMaterialInstanceDynamic *DynamicMaterial =
-        UMaterialInstanceDynamic::Create(TextMaterial, TextComponent->GetOwner());
-    if (DynamicMaterial == nullptr)
+    TArray<FSoftObjectPath> MaterialPaths;
+    MaterialPaths.Emplace(TEXT_MATERIAL_PATH);
+    if (Settings->GetFacingMode() == EEditorActorTagDisplayFacingMode::GPU)
     {
-        TextComponent->SetTextMaterial(TextMaterial);
+        MaterialPaths.Add(Settings->GetBillboardTextMaterial().ToSoftObjectPath());
+    }
+
+    if (!UAssetManager::IsInitialized())
+    {
+        // NOLINTNEXTLINE
+        UE_LOG(LogEditorActorTagDisplay, Warning,
+               TEXT("Asset manager is not initialized. Labels use the default text material."));
+        OnTextMaterialsLoaded();
         return;
     }
 
+    // 読み込み済みの場合、完了通知はこの呼び出しの中で行われる
+    TextMaterialLoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+        MoveTemp(MaterialPaths),
+        FStreamableDelegate::CreateRaw(this, &FEditorActorTagDisplayModule::OnTextMaterialsLoaded));
+    if (!TextMaterialLoadHandle.IsValid() && !bAreTextMaterialsLoaded)
+    {
+        OnTextMaterialsLoaded();
+    }
+}
+
+auto FEditorActorTagDisplayModule::OnTextMaterialsLoaded() -> void
+{
+    bAreTextMaterialsLoaded = true;
+
+    // パスの解決は読み込み完了時の1回だけ行い、ラベルの生成時には解決済みのマテリアルを使う
+    TextBaseMaterial = Cast<UMaterialInterface>(FSoftObjectPath(TEXT_MATERIAL_PATH).ResolveObject());
+    if (TextBaseMaterial == nullptr)
+    {
+        // NOLINTNEXTLINE
+        UE_LOG(LogEditorActorTagDisplay, Error, TEXT("Failed to load text material from %s"), TEXT_MATERIAL_PATH);
+    }
+
+    // 読み込みを待っていたラベルを次のティックで生成させる
+    MarkAllLabelContextsDirty();
+}
+
+auto FEditorActorTagDisplayModule::WaitForTextMaterials() -> void
+{
+    if (TextMaterialLoadHandle.IsValid())
+    {
+        TextMaterialLoadHandle->WaitUntilComplete();
+    }
+    if (bIsModuleActive && !bAreTextMaterialsLoaded)
+    {
+        OnTextMaterialsLoaded();
+    }
+}
+
+auto FEditorActorTagDisplayModule::GetTextBaseMaterial() -> UMaterialInterface *
+{
+    return TextBaseMaterial;
+}
+
+auto FEditorActorTagDisplayModule::GetOrCreateSharedTextMaterial() -> UMaterialInterface *
+{
+    if (SharedTextMaterial != nullptr)
+    {
+        return SharedTextMaterial;
+    }
+
     const UEditorActorTagDisplaySettings *Settings = UEditorActorTagDisplaySettings::Get();
-    if (Settings != nullptr)
+    // NOLINTNEXTLINE
+    check(Settings != nullptr);
+
+    // GPUモードではビルボードマテリアルを親にし、読み込めなければ通常のマテリアルとCPUでの回転に戻す
+    UMaterialInterface *TextMaterial = nullptr;
+    bIsMaterialBillboardActive = false;
+    if (Settings->GetFacingMode() == EEditorActorTagDisplayFacingMode::GPU)
+    {
+        TextMaterial = Settings->GetBillboardTextMaterial().Get();
+        if (TextMaterial == nullptr)
+        {
+            // NOLINTNEXTLINE
+            UE_LOG(LogEditorActorTagDisplay, Warning,
+                   TEXT("Billboard text material '%s' could not be loaded. Falling back to CPU facing."),
+                   *Settings->GetBillboardTextMaterial().ToString());
+        }
+    }
+
+    if (TextMaterial == nullptr)
+    {
+        TextMaterial = GetTextBaseMaterial();
+        if (TextMaterial == nullptr)
+        {
+            return nullptr;
+        }
+    }
+    else
+    {
+        bIsMaterialBillboardActive = true;
+    }
+
+    SharedTextMaterial = UMaterialInstanceDynamic::Create(TextMaterial, GetTransientPackage());
+    if (SharedTextMaterial == nullptr)
+    {
+        return TextMaterial;
+    }
+
+    SharedTextMaterial->SetScalarParameterValue(TEXT("OutlineWidth"), Settings->GetOutlineWidth());
+    return SharedTextMaterial;
+}
+
+auto FEditorActorTagDisplayModule::ResetTextMaterials() -> void
+{
+    // 既存のラベルとプールのアクターは古いマテリアルと向きを持っているため作り直す
+    for (auto &Pair : LabelContexts)
+    {
+        CleanupTextActors(*Pair.Value);
+        EmptyTextActorPool(*Pair.Value);
+    }
+
+    SharedTextMaterial = nullptr;
+    bIsMaterialBillboardActive = false;
+
+    // ビルボードマテリアルが変わった場合に備えて読み込み直す（読み込み済みであればすぐに完了する）
+    if (bIsModuleActive)
     {
-        DynamicMaterial->SetScalarParameterValue(TEXT("OutlineWidth"), Settings->GetOutlineWidth());
+        RequestTextMaterials();
     }
-    TextComponent->SetTextMaterial(DynamicMaterial);
+}
+
+auto FEditorActorTagDisplayModule::AddReferencedObjects(FReferenceCollector &Collector) -> void
+{
+    Collector.AddReferencedObject(TextBaseMaterial);
+    Collector.AddReferencedObject(SharedTextMaterial);
 }
 
 auto FEditorActorTagDisplayModule::UpdateAllTextActorSizes() -> void
@@ -460,18 +2681,26 @@ auto FEditorActorTagDisplayModule::UpdateAllTextActorSizes() -> void
 
     const float NewTextSize = Settings->GetTextSize();
 
-    // 既存のすべてのTextActorのサイズを更新
-    for (auto &Pair : TextActorMap)
+    for (const auto &ContextPair : LabelContexts)
     {
-        if (Pair.Value.IsValid())
+        const FLabelContext &Context = *ContextPair.Value;
+        if (Context.BatchActor.IsValid())
         {
-            AEditorActorTagDisplayActor *TextActor = Pair.Value.Get();
-            UTextRenderComponent *TextComponent = TextActor->GetTextRenderComponent();
-            if (TextComponent != nullptr)
-            {
-                TextComponent->SetWorldSize(NewTextSize);
-            }
+            Context.BatchActor->GetBatchComponent()->SetTextSize(NewTextSize);
         }
+
+        // 既存のすべてのTextActorのサイズを更新
+        Context.Labels.ForEachLabel(
+            [&Context, NewTextSize](int32 LabelHandle) -> void
+            {
+                const AEditorActorTagDisplayActor *TextActor = Context.Labels.GetEntry(LabelHandle).TextActor.Get();
+                UTextRenderComponent *TextComponent =
+                    TextActor != nullptr ? TextActor->GetTextRenderComponent() : nullptr;
+                if (TextComponent != nullptr)
+                {
+                    TextComponent->SetWorldSize(NewTextSize);
+                }
+            });
     }
 }
 
@@ -485,24 +2714,136 @@ auto FEditorActorTagDisplayModule::UpdateAllTextActorOutlineWidth() -> void
 
     const float NewOutlineWidth = Settings->GetOutlineWidth();
 
-    // 既存のすべてのTextActorのOutlineWidthを更新
-    for (auto &Pair : TextActorMap)
+    for (const auto &ContextPair : LabelContexts)
     {
-        if (Pair.Value.IsValid())
+        const AEditorActorTagDisplayBatchActor *BatchActor = ContextPair.Value->BatchActor.Get();
+        if (BatchActor == nullptr)
+        {
+            continue;
+        }
+        if (UMaterialInstanceDynamic *DynamicMaterial = BatchActor->GetBatchComponent()->GetTextMaterialInstance())
         {
-            AEditorActorTagDisplayActor *TextActor = Pair.Value.Get();
-            UTextRenderComponent *TextComponent = TextActor->GetTextRenderComponent();
-            if (TextComponent != nullptr)
+            DynamicMaterial->SetScalarParameterValue(TEXT("OutlineWidth"), NewOutlineWidth);
+        }
+    }
+
+    // すべてのTextActorは共有インスタンスを参照しているため、書き込みは1回で済む
+    if (SharedTextMaterial != nullptr)
+    {
+        SharedTextMaterial->SetScalarParameterValue(TEXT("OutlineWidth"), NewOutlineWidth);
+    }
+}
+
+auto FEditorActorTagDisplayModule::DumpWriteStats(const TArray<FString> &Args) -> void
+{
+    const auto LogCounter = [](const TCHAR *Name, const FWriteCounter &Counter) -> void
+    {
+        // NOLINTNEXTLINE
+        UE_LOG(LogEditorActorTagDisplay, Display, TEXT("%-8s issued: %llu, skipped: %llu"), Name, Counter.Issued,
+               Counter.Skipped);
+    };
+
+    LogCounter(TEXT("Text"), TextWriteCounter);
+    LogCounter(TEXT("Color"), ColorWriteCounter);
+    LogCounter(TEXT("Location"), LocationWriteCounter);
+    LogCounter(TEXT("Rotation"), RotationWriteCounter);
+
+    if (Args.Contains(TEXT("reset")))
+    {
+        TextWriteCounter = FWriteCounter();
+        ColorWriteCounter = FWriteCounter();
+        LocationWriteCounter = FWriteCounter();
+        RotationWriteCounter = FWriteCounter();
+    }
+}
+
+auto FEditorActorTagDisplayModule::UpdateFrameStats() const -> void
+{
+#if STATS
+    const bool bIsCollectingStats = FThreadStats::IsCollectingData();
+#else
+    const bool bIsCollectingStats = false;
+#endif
+#if CSV_PROFILER
+    const bool bIsCapturingCsv = FCsvProfiler::Get()->IsCapturing();
+#else
+    const bool bIsCapturingCsv = false;
+#endif
+
+    // ラベル数に比例する集計は、統計を収集している間だけ行う
+    if (!bIsCollectingStats && !bIsCapturingCsv)
+    {
+        return;
+    }
+
+    // 統計はすべてのワールドのコンテキストの合計
+    int32 NumTrackedActors = 0;
+    int32 NumLiveLabels = 0;
+    int32 NumPooledLabels = 0;
+    int32 NumPendingLabelWork = 0;
+    int32 NumLabelActors = 0;
+    int32 NumBatchActors = 0;
+    int32 NumGlyphs = 0;
+    int32 NumSharedGlyphLayouts = 0;
+    int32 NumMaterialInstances = SharedTextMaterial != nullptr ? 1 : 0;
+    for (const auto &ContextPair : LabelContexts)
+    {
+        const FLabelContext &Context = *ContextPair.Value;
+        NumTrackedActors += Context.TrackedActors.Num();
+        NumLiveLabels += Context.Labels.Num();
+        NumPooledLabels += Context.TextActorPool.Num();
+        NumPendingLabelWork += Context.PendingLabelWork.Num();
+        NumLabelActors += Context.TextActorPool.Num();
+        Context.Labels.ForEachLabel(
+            [&Context, &NumLabelActors, &NumGlyphs](int32 LabelHandle) -> void
             {
-                // 既存のマテリアルインスタンスのパラメータを更新
-                UMaterialInterface *Material = TextComponent->GetMaterial(0);
-                if (UMaterialInstanceDynamic *DynamicMaterial = Cast<UMaterialInstanceDynamic>(Material))
+                const FTextActorEntry &Entry = Context.Labels.GetEntry(LabelHandle);
+                if (Entry.TextActor.IsValid())
                 {
-                    DynamicMaterial->SetScalarParameterValue(TEXT("OutlineWidth"), NewOutlineWidth);
+                    ++NumLabelActors;
                 }
+                NumGlyphs += Entry.NumGlyphs;
+            });
+
+        if (const AEditorActorTagDisplayBatchActor *BatchActor = Context.BatchActor.Get())
+        {
+            ++NumBatchActors;
+            NumSharedGlyphLayouts += BatchActor->GetBatchComponent()->GetNumSharedGlyphLayouts();
+            if (BatchActor->GetBatchComponent()->GetTextMaterialInstance() != nullptr)
+            {
+                ++NumMaterialInstances;
             }
         }
     }
+
+    // ラベルアクターとバッチアクターは、それぞれアクターとルートコンポーネントの2つのUObjectを持つ
+    const int32 NumLabelObjects = (NumLabelActors + NumBatchActors) * 2;
+    const int32 NumTextMeshVertices = NumGlyphs * 4; // グリフごとに1枚の四角形
+
+    SET_DWORD_STAT(STAT_EditorActorTagDisplay_TrackedActors, NumTrackedActors);
+    SET_DWORD_STAT(STAT_EditorActorTagDisplay_LiveLabels, NumLiveLabels);
+    SET_DWORD_STAT(STAT_EditorActorTagDisplay_PooledLabels, NumPooledLabels);
+    SET_DWORD_STAT(STAT_EditorActorTagDisplay_PendingLabelWork, NumPendingLabelWork);
+    SET_DWORD_STAT(STAT_EditorActorTagDisplay_LabelObjects, NumLabelObjects);
+    SET_DWORD_STAT(STAT_EditorActorTagDisplay_MaterialInstances, NumMaterialInstances);
+    SET_DWORD_STAT(STAT_EditorActorTagDisplay_TextMeshVertices, NumTextMeshVertices);
+    SET_DWORD_STAT(STAT_EditorActorTagDisplay_SharedGlyphLayouts, NumSharedGlyphLayouts);
+
+    CSV_CUSTOM_STAT(EditorActorTagDisplay, TrackedActors, NumTrackedActors, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(EditorActorTagDisplay, LiveLabels, NumLiveLabels, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(EditorActorTagDisplay, LabelObjects, NumLabelObjects, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(EditorActorTagDisplay, TextMeshVertices, NumTextMeshVertices, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(EditorActorTagDisplay, SharedGlyphLayouts, NumSharedGlyphLayouts, ECsvCustomStatOp::Set);
+}
+
+auto FEditorActorTagDisplayModule::GetNumLabels() const -> int32
+{
+    int32 NumLabels = 0;
+    for (const auto &Pair : LabelContexts)
+    {
+        NumLabels += Pair.Value->Labels.Num();
+    }
+    return NumLabels;
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -10,10 +10,42 @@ UEditorActorTagDisplaySettings::UEditorActorTagDisplaySettings()
     SectionName = TEXT("Actor Tag Display");
 }
 
-auto UEditorActorTagDisplaySettings::SetTagDisplayEnabled(bool bEnabled) -> void
+auto UEditorActorTagDisplaySettings::PostInitProperties() -> void
 {
+    Super::PostInitProperties();
+
+    // 設定ファイルから読み込んだビルボードマテリアルの有無をFacingModeの表示条件に反映する
+    bHasBillboardTextMaterial = !BillboardTextMaterial.IsNull();
+}
+
+auto UEditorActorTagDisplaySettings::SetTagDisplayEnabled(bool bEnabled, bool bSaveToConfig) -> void
+{
+    if (bIsTagDisplayEnabled == bEnabled)
+    {
+        return; // 値が変わっていない場合は何もしない
+    }
+
     bIsTagDisplayEnabled = bEnabled;
-    SaveConfig();
+    if (bSaveToConfig)
+    {
+        SaveConfig();
+    }
+
+    // デリゲートを呼び出してティッカーの登録を切り替える
+    OnTagDisplayEnabledChanged.Broadcast(bIsTagDisplayEnabled);
+}
+
+auto UEditorActorTagDisplaySettings::SetClassConfigs(const TArray<FActorClassTagDisplayConfig> &InClassConfigs,
+                                                     bool bSaveToConfig) -> void
+{
+    ClassConfigs = InClassConfigs;
+    if (bSaveToConfig)
+    {
+        SaveConfig();
+    }
+
+    // デリゲートを呼び出してクラス一致キャッシュを破棄
+    OnClassConfigsChanged.Broadcast();
 }
 
 auto UEditorActorTagDisplaySettings::SetTextSize(float InTextSize) -> void
@@ -68,6 +100,25 @@ auto UEditorActorTagDisplaySettings::PostEditChangeProperty(FPropertyChangedEven
         {
             OnOutlineWidthChanged.Broadcast(OutlineWidth);
         }
+        // カメラへの向け方が変わった場合は使用するマテリアルも変わる
+        else if (PropertyName == GET_MEMBER_NAME_CHECKED(UEditorActorTagDisplaySettings, FacingMode) ||
+                 PropertyName == GET_MEMBER_NAME_CHECKED(UEditorActorTagDisplaySettings, BillboardTextMaterial))
+        {
+            bHasBillboardTextMaterial = !BillboardTextMaterial.IsNull();
+            OnTextMaterialChanged.Broadcast();
+        }
+        // 表示の有効・無効が切り替わった場合、デリゲートを呼び出す
+        else if (PropertyName == GET_MEMBER_NAME_CHECKED(UEditorActorTagDisplaySettings, bIsTagDisplayEnabled))
+        {
+            OnTagDisplayEnabledChanged.Broadcast(bIsTagDisplayEnabled);
+        }
+    }
+
+    // ClassConfigsは配列要素の編集でもMemberPropertyとして通知される
+    if (PropertyChangedEvent.GetMemberPropertyName() ==
+        GET_MEMBER_NAME_CHECKED(UEditorActorTagDisplaySettings, ClassConfigs))
+    {
+        OnClassConfigsChanged.Broadcast();
     }
 }
 #endif
@@ -0,0 +1,168 @@
+#include "EditorActorTagDisplaySpatialIndex.h"
+#include "ConvexVolume.h"
+#include "GameFramework/Actor.h"
+
+FEditorActorTagDisplaySpatialIndex::FEditorActorTagDisplaySpatialIndex(double InCellSize)
+    : CellSize(FMath::Max(InCellSize, 1.0))
+{
+}
+
+auto FEditorActorTagDisplaySpatialIndex::Update(AActor *Actor, const FVector &Position) -> void
+{
+    // NOLINTNEXTLINE
+    check(Actor != nullptr);
+
+    const FIntVector Cell = GetCell(Position);
+
+    if (const int32 *ExistingIndex = ElementIndices.Find(Actor))
+    {
+        FElement &Element = Elements[*ExistingIndex];
+        Element.Position = Position;
+        if (Element.Cell != Cell)
+        {
+            RemoveFromCell(*ExistingIndex, Element.Cell);
+            Element.Cell = Cell;
+            Cells.FindOrAdd(Cell).Add(*ExistingIndex);
+        }
+        return;
+    }
+
+    FElement NewElement;
+    NewElement.Actor = Actor;
+    NewElement.Position = Position;
+    NewElement.Cell = Cell;
+
+    const int32 ElementIndex = Elements.Add(MoveTemp(NewElement));
+    ElementIndices.Add(Actor, ElementIndex);
+    Cells.FindOrAdd(Cell).Add(ElementIndex);
+}
+
+auto FEditorActorTagDisplaySpatialIndex::Remove(const TWeakObjectPtr<AActor> &Actor) -> void
+{
+    int32 ElementIndex = INDEX_NONE;
+    if (!ElementIndices.RemoveAndCopyValue(Actor, ElementIndex))
+    {
+        return;
+    }
+
+    RemoveFromCell(ElementIndex, Elements[ElementIndex].Cell);
+    Elements.RemoveAt(ElementIndex);
+}
+
+auto FEditorActorTagDisplaySpatialIndex::Reset() -> void
+{
+    Elements.Reset();
+    ElementIndices.Reset();
+    Cells.Reset();
+}
+
+auto FEditorActorTagDisplaySpatialIndex::QueryView(const FConvexVolume &Frustum, const FVector &ViewOrigin,
+                                                   double MaxDistance, double ElementRadius,
+                                                   TArray<AActor *> &OutActors) const -> void
+{
+    const bool bHasDistanceLimit = MaxDistance > 0.0;
+    const double MaxDistanceSquared = bHasDistanceLimit ? FMath::Square(MaxDistance) : TNumericLimits<double>::Max();
+
+    // 距離範囲内のセル数が使用中のセル数より少なければ範囲を、そうでなければ使用中のセルを走査する
+    if (bHasDistanceLimit)
+    {
+        const FIntVector MinCell = GetCell(ViewOrigin - FVector(MaxDistance));
+        const FIntVector MaxCell = GetCell(ViewOrigin + FVector(MaxDistance));
+        const FIntVector CellCount = MaxCell - MinCell + FIntVector(1);
+        const int64 NumRangeCells = static_cast<int64>(CellCount.X) * CellCount.Y * CellCount.Z;
+
+        if (NumRangeCells <= Cells.Num())
+        {
+            for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+            {
+                for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+                {
+                    for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+                    {
+                        const FIntVector Cell(X, Y, Z);
+                        if (const TArray<int32> *CellElements = Cells.Find(Cell))
+                        {
+                            GatherCell(Cell, *CellElements, Frustum, ViewOrigin, MaxDistanceSquared, ElementRadius,
+                                       OutActors);
+                        }
+                    }
+                }
+            }
+            return;
+        }
+    }
+
+    for (const TPair<FIntVector, TArray<int32>> &Pair : Cells)
+    {
+        GatherCell(Pair.Key, Pair.Value, Frustum, ViewOrigin, MaxDistanceSquared, ElementRadius, OutActors);
+    }
+}
+
+auto FEditorActorTagDisplaySpatialIndex::GatherAll(TArray<AActor *> &OutActors) const -> void
+{
+    OutActors.Reserve(OutActors.Num() + Elements.Num());
+    for (const FElement &Element : Elements)
+    {
+        if (AActor *Actor = Element.Actor.Get())
+        {
+            OutActors.Add(Actor);
+        }
+    }
+}
+
+auto FEditorActorTagDisplaySpatialIndex::GetCell(const FVector &Position) const -> FIntVector
+{
+    return {FMath::FloorToInt32(Position.X / CellSize), FMath::FloorToInt32(Position.Y / CellSize),
+            FMath::FloorToInt32(Position.Z / CellSize)};
+}
+
+auto FEditorActorTagDisplaySpatialIndex::GetCellBox(const FIntVector &Cell) const -> FBox
+{
+    const FVector Min(static_cast<double>(Cell.X) * CellSize, static_cast<double>(Cell.Y) * CellSize,
+                      static_cast<double>(Cell.Z) * CellSize);
+    return {Min, Min + FVector(CellSize)};
+}
+
+auto FEditorActorTagDisplaySpatialIndex::RemoveFromCell(int32 ElementIndex, const FIntVector &Cell) -> void
+{
+    TArray<int32> *CellElements = Cells.Find(Cell);
+    if (CellElements == nullptr)
+    {
+        return;
+    }
+
+    CellElements->RemoveSingleSwap(ElementIndex, EAllowShrinking::No);
+    if (CellElements->IsEmpty())
+    {
+        Cells.Remove(Cell);
+    }
+}
+
+auto FEditorActorTagDisplaySpatialIndex::GatherCell(const FIntVector &Cell, const TArray<int32> &CellElements,
+                                                    const FConvexVolume &Frustum, const FVector &ViewOrigin,
+                                                    double MaxDistanceSquared, double ElementRadius,
+                                                    TArray<AActor *> &OutActors) const -> void
+{
+    // セル全体が範囲外・視錐台外であれば要素ごとの判定を省く
+    const FBox CellBox = GetCellBox(Cell).ExpandBy(ElementRadius);
+    if (CellBox.ComputeSquaredDistanceToPoint(ViewOrigin) > MaxDistanceSquared ||
+        !Frustum.IntersectBox(CellBox.GetCenter(), CellBox.GetExtent()))
+    {
+        return;
+    }
+
+    for (const int32 ElementIndex : CellElements)
+    {
+        const FElement &Element = Elements[ElementIndex];
+        if (FVector::DistSquared(Element.Position, ViewOrigin) > MaxDistanceSquared ||
+            !Frustum.IntersectSphere(Element.Position, static_cast<float>(ElementRadius)))
+        {
+            continue;
+        }
+
+        if (AActor *Actor = Element.Actor.Get())
+        {
+            OutActors.Add(Actor);
+        }
+    }
+}
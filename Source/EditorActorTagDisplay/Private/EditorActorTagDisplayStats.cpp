@@ -0,0 +1,31 @@
+#include "EditorActorTagDisplayStats.h"
+
+// NOLINTBEGIN
+DEFINE_STAT(STAT_EditorActorTagDisplay_Update);
+DEFINE_STAT(STAT_EditorActorTagDisplay_ProcessActorsInWorld);
+DEFINE_STAT(STAT_EditorActorTagDisplay_SweepTrackedWorld);
+DEFINE_STAT(STAT_EditorActorTagDisplay_ProcessDirtyActors);
+DEFINE_STAT(STAT_EditorActorTagDisplay_RefreshRotations);
+DEFINE_STAT(STAT_EditorActorTagDisplay_MaterializeVisibleLabels);
+DEFINE_STAT(STAT_EditorActorTagDisplay_DrainLabelWork);
+DEFINE_STAT(STAT_EditorActorTagDisplay_BuildSnapshot);
+DEFINE_STAT(STAT_EditorActorTagDisplay_CreateOrUpdateTextActor);
+DEFINE_STAT(STAT_EditorActorTagDisplay_GetOrCreateTextActor);
+DEFINE_STAT(STAT_EditorActorTagDisplay_RemoveUnusedTextActors);
+DEFINE_STAT(STAT_EditorActorTagDisplay_DrawCanvasOverlay);
+
+DEFINE_STAT(STAT_EditorActorTagDisplay_TrackedActors);
+DEFINE_STAT(STAT_EditorActorTagDisplay_LiveLabels);
+DEFINE_STAT(STAT_EditorActorTagDisplay_PooledLabels);
+DEFINE_STAT(STAT_EditorActorTagDisplay_PendingLabelWork);
+DEFINE_STAT(STAT_EditorActorTagDisplay_LabelObjects);
+DEFINE_STAT(STAT_EditorActorTagDisplay_MaterialInstances);
+DEFINE_STAT(STAT_EditorActorTagDisplay_TextMeshVertices);
+DEFINE_STAT(STAT_EditorActorTagDisplay_SharedGlyphLayouts);
+
+DEFINE_STAT(STAT_EditorActorTagDisplay_Spawns);
+DEFINE_STAT(STAT_EditorActorTagDisplay_Destroys);
+DEFINE_STAT(STAT_EditorActorTagDisplay_TextRebuilds);
+
+CSV_DEFINE_CATEGORY_MODULE(EDITORACTORTAGDISPLAY_API, EditorActorTagDisplay, true);
+// NOLINTEND
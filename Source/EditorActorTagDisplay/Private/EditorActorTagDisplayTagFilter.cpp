@@ -0,0 +1,142 @@
+#include "EditorActorTagDisplayTagFilter.h"
+
+FEditorActorTagDisplayTagFilter::FEditorActorTagDisplayTagFilter(TConstArrayView<FString> IncludePatterns,
+                                                                 TConstArrayView<FString> ExcludePatterns)
+{
+    for (const FString &Pattern : IncludePatterns)
+    {
+        Include.Add(Pattern);
+    }
+    for (const FString &Pattern : ExcludePatterns)
+    {
+        Exclude.Add(Pattern);
+    }
+}
+
+auto FEditorActorTagDisplayTagFilter::PassesTag(FName Tag) -> bool
+{
+    if (IsEmpty())
+    {
+        return true;
+    }
+
+    // 完全一致のみの場合は文字列化せずに判定できる
+    if (!Include.HasStringRules() && !Exclude.HasStringRules())
+    {
+        return (Include.IsEmpty() || Include.ExactNames.Contains(Tag)) && !Exclude.ExactNames.Contains(Tag);
+    }
+
+    // 前方一致・ワイルドカードはタグごとに一度だけ文字列で判定し、結果を再利用する
+    if (const bool *Decision = Decisions.Find(Tag))
+    {
+        return *Decision;
+    }
+    return Decisions.Add(Tag, Evaluate(Tag));
+}
+
+auto FEditorActorTagDisplayTagFilter::PassesAny(TConstArrayView<FName> Tags) -> bool
+{
+    if (IsEmpty())
+    {
+        return !Tags.IsEmpty();
+    }
+
+    for (const FName &Tag : Tags)
+    {
+        if (PassesTag(Tag))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+auto FEditorActorTagDisplayTagFilter::AppendPassingTags(TConstArrayView<FName> Tags, TArray<FName> &OutTags) -> int32
+{
+    if (IsEmpty())
+    {
+        OutTags.Append(Tags.GetData(), Tags.Num());
+        return Tags.Num();
+    }
+
+    int32 NumAppended = 0;
+    for (const FName &Tag : Tags)
+    {
+        if (PassesTag(Tag))
+        {
+            OutTags.Add(Tag);
+            ++NumAppended;
+        }
+    }
+    return NumAppended;
+}
+
+auto FEditorActorTagDisplayTagFilter::Evaluate(FName Tag) const -> bool
+{
+    // 完全一致で決まる場合は文字列を作らない
+    if (Exclude.ExactNames.Contains(Tag))
+    {
+        return false;
+    }
+    const bool bIncludedByName = Include.IsEmpty() || Include.ExactNames.Contains(Tag);
+    if (bIncludedByName && !Exclude.HasStringRules())
+    {
+        return true;
+    }
+    if (!bIncludedByName && !Include.HasStringRules())
+    {
+        return false;
+    }
+
+    const FString TagString = Tag.ToString();
+    return (bIncludedByName || Include.MatchesString(TagString)) && !Exclude.MatchesString(TagString);
+}
+
+auto FEditorActorTagDisplayTagFilter::FRuleSet::Add(const FString &Pattern) -> void
+{
+    FString TrimmedPattern = Pattern.TrimStartAndEnd();
+    if (TrimmedPattern.IsEmpty())
+    {
+        return;
+    }
+
+    int32 WildcardIndex = INDEX_NONE;
+    TrimmedPattern.FindChar(TEXT('*'), WildcardIndex);
+    int32 SingleWildcardIndex = INDEX_NONE;
+    TrimmedPattern.FindChar(TEXT('?'), SingleWildcardIndex);
+
+    // ワイルドカードを含まないパターンはFNameの比較で判定する
+    if (WildcardIndex == INDEX_NONE && SingleWildcardIndex == INDEX_NONE)
+    {
+        ExactNames.Add(FName(*TrimmedPattern));
+        return;
+    }
+
+    // 末尾の「*」のみのパターンは前方一致として扱う
+    if (SingleWildcardIndex == INDEX_NONE && WildcardIndex == TrimmedPattern.Len() - 1)
+    {
+        Prefixes.Add(TrimmedPattern.LeftChop(1));
+        return;
+    }
+
+    Wildcards.Add(MoveTemp(TrimmedPattern));
+}
+
+auto FEditorActorTagDisplayTagFilter::FRuleSet::MatchesString(const FString &TagString) const -> bool
+{
+    for (const FString &Prefix : Prefixes)
+    {
+        if (TagString.StartsWith(Prefix, ESearchCase::IgnoreCase))
+        {
+            return true;
+        }
+    }
+    for (const FString &Wildcard : Wildcards)
+    {
+        if (TagString.MatchesWildcard(Wildcard, ESearchCase::IgnoreCase))
+        {
+            return true;
+        }
+    }
+    return false;
+}
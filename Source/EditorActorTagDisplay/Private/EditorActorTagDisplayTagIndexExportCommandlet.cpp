@@ -0,0 +1,479 @@
+#include "EditorActorTagDisplayTagIndexExportCommandlet.h"
+#include "EditorActorTagDisplayAnchorCache.h"
+#include "EditorActorTagDisplayConfigMatcher.h"
+#include "EditorActorTagDisplaySettings.h"
+#include "EditorActorTagDisplayLog.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Level.h"
+#include "Engine/MapBuildDataRegistry.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/MemoryWriter.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UObjectHash.h"
+
+namespace
+{
+/** One matching actor of a map. */
+struct FExportedActor
+{
+    FString ActorPath;
+    int32 ClassIndex = INDEX_NONE;
+    int32 ConfigIndex = INDEX_NONE;
+    TArray<int32> TagIndices;
+    FVector3f Anchor = FVector3f::ZeroVector;
+};
+
+/** Index of one map. Class paths and tags are stored once in the string table. */
+struct FMapTagIndex
+{
+    TArray<FString> Strings;
+    TMap<FString, int32> StringIndices;
+    TArray<FExportedActor> Actors;
+
+    auto AddString(const FString &String) -> int32
+    {
+        if (const int32 *ExistingIndex = StringIndices.Find(String))
+        {
+            return *ExistingIndex;
+        }
+        return StringIndices.Add(String, Strings.Add(String));
+    }
+};
+
+auto NormalizeMapPackageName(const FString &Name, FString &OutPackageName) -> bool
+{
+    FString PackageName = Name.TrimStartAndEnd();
+    if (PackageName.IsEmpty() || PackageName.StartsWith(TEXT("#")))
+    {
+        return false;
+    }
+
+    // 「/Game/Maps/Map.Map」のようなオブジェクトパスも受け付ける
+    PackageName = FPackageName::ObjectPathToPackageName(PackageName);
+    if (!FPackageName::IsValidLongPackageName(PackageName))
+    {
+        // NOLINTNEXTLINE
+        UE_LOG(LogEditorActorTagDisplay, Warning, TEXT("Skipping invalid map package name '%s'."), *Name);
+        return false;
+    }
+
+    OutPackageName = MoveTemp(PackageName);
+    return true;
+}
+
+auto GatherMapPackageNames(const FString &Params) -> TArray<FString>
+{
+    TArray<FString> Names;
+
+    FString MapsParam;
+    if (FParse::Value(*Params, TEXT("Maps="), MapsParam, false))
+    {
+        MapsParam.ParseIntoArray(Names, TEXT(","));
+    }
+
+    FString MapListPath;
+    if (FParse::Value(*Params, TEXT("MapList="), MapListPath))
+    {
+        TArray<FString> Lines;
+        if (FFileHelper::LoadFileToStringArray(Lines, *MapListPath))
+        {
+            Names.Append(Lines);
+        }
+        else
+        {
+            // NOLINTNEXTLINE
+            UE_LOG(LogEditorActorTagDisplay, Error, TEXT("Failed to read map list %s"), *MapListPath);
+        }
+    }
+
+    // プロジェクトのすべてのマップ（エンジン・プラグインのマップは含めない）
+    if (FParse::Param(*Params, TEXT("AllMaps")))
+    {
+        IAssetRegistry &AssetRegistry =
+            FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+        AssetRegistry.SearchAllAssets(true);
+
+        TArray<FAssetData> WorldAssets;
+        AssetRegistry.GetAssetsByClass(UWorld::StaticClass()->GetClassPathName(), WorldAssets);
+        for (const FAssetData &Asset : WorldAssets)
+        {
+            const FString PackageName = Asset.PackageName.ToString();
+            if (PackageName.StartsWith(TEXT("/Game/")))
+            {
+                Names.Add(PackageName);
+            }
+        }
+    }
+
+    TArray<FString> PackageNames;
+    for (const FString &Name : Names)
+    {
+        FString PackageName;
+        if (NormalizeMapPackageName(Name, PackageName))
+        {
+            PackageNames.AddUnique(PackageName);
+        }
+    }
+    return PackageNames;
+}
+
+auto ClearStandaloneFlags(UWorld *World) -> void
+{
+    // エディターはRF_Standaloneを持つマップを参照がなくても保持するため、処理済みのマップから外して解放させる
+    TArray<UPackage *, TInlineAllocator<4>> Packages;
+    Packages.Add(World->GetPackage());
+    for (const ULevel *Level : World->GetLevels())
+    {
+        if (Level != nullptr && Level->MapBuildData != nullptr)
+        {
+            Packages.AddUnique(Level->MapBuildData->GetPackage());
+        }
+    }
+
+    for (UPackage *Package : Packages)
+    {
+        Package->ClearFlags(RF_Standalone);
+        ForEachObjectWithPackage(Package,
+                                 [](UObject *Object) -> bool
+                                 {
+                                     Object->ClearFlags(RF_Standalone);
+                                     return true;
+                                 },
+                                 false);
+    }
+}
+
+auto GetIndexFileBaseName(const FString &PackageName) -> FString
+{
+    // 「/Game/Maps/Map」→「Game_Maps_Map」
+    return PackageName.RightChop(1).Replace(TEXT("/"), TEXT("_"));
+}
+
+auto WriteBinaryIndex(FMapTagIndex &Index, const FString &Path) -> bool
+{
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+
+    uint32 Magic = UEditorActorTagDisplayTagIndexExportCommandlet::BinaryMagic;
+    uint32 Version = UEditorActorTagDisplayTagIndexExportCommandlet::BinaryVersion;
+    Writer << Magic;
+    Writer << Version;
+    Writer << Index.Strings;
+
+    int32 NumActors = Index.Actors.Num();
+    Writer << NumActors;
+    for (FExportedActor &Actor : Index.Actors)
+    {
+        Writer << Actor.ActorPath;
+        Writer << Actor.ClassIndex;
+        Writer << Actor.ConfigIndex;
+        Writer << Actor.TagIndices;
+        Writer << Actor.Anchor;
+    }
+
+    return FFileHelper::SaveArrayToFile(Bytes, *Path);
+}
+
+auto WriteJsonIndex(const FMapTagIndex &Index, const FString &PackageName, const FString &Path) -> bool
+{
+    TArray<TSharedPtr<FJsonValue>> ActorValues;
+    ActorValues.Reserve(Index.Actors.Num());
+    for (const FExportedActor &Actor : Index.Actors)
+    {
+        const TSharedRef<FJsonObject> ActorObject = MakeShared<FJsonObject>();
+        ActorObject->SetStringField(TEXT("Path"), Actor.ActorPath);
+        ActorObject->SetStringField(TEXT("Class"), Index.Strings[Actor.ClassIndex]);
+        ActorObject->SetNumberField(TEXT("ConfigIndex"), Actor.ConfigIndex);
+
+        TArray<TSharedPtr<FJsonValue>> TagValues;
+        for (const int32 TagIndex : Actor.TagIndices)
+        {
+            TagValues.Add(MakeShared<FJsonValueString>(Index.Strings[TagIndex]));
+        }
+        ActorObject->SetArrayField(TEXT("Tags"), TagValues);
+
+        ActorObject->SetArrayField(TEXT("Anchor"), {MakeShared<FJsonValueNumber>(Actor.Anchor.X),
+                                                    MakeShared<FJsonValueNumber>(Actor.Anchor.Y),
+                                                    MakeShared<FJsonValueNumber>(Actor.Anchor.Z)});
+        ActorValues.Add(MakeShared<FJsonValueObject>(ActorObject));
+    }
+
+    const TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+    Root->SetStringField(TEXT("Map"), PackageName);
+    Root->SetArrayField(TEXT("Actors"), ActorValues);
+
+    FString Json;
+    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+    FJsonSerializer::Serialize(Root, Writer);
+    return FFileHelper::SaveStringToFile(Json, *Path);
+}
+} // namespace
+
+UEditorActorTagDisplayTagIndexExportCommandlet::UEditorActorTagDisplayTagIndexExportCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+auto UEditorActorTagDisplayTagIndexExportCommandlet::Main(const FString &Params) -> int32
+{
+    const UEditorActorTagDisplaySettings *Settings = UEditorActorTagDisplaySettings::Get();
+    if (Settings == nullptr)
+    {
+        // NOLINTNEXTLINE
+        UE_LOG(LogEditorActorTagDisplay, Error, TEXT("Tag index export requires the plugin settings."));
+        return 1;
+    }
+
+    const TArray<FString> PackageNames = GatherMapPackageNames(Params);
+    if (PackageNames.IsEmpty())
+    {
+        // NOLINTNEXTLINE
+        UE_LOG(LogEditorActorTagDisplay, Error, TEXT("No maps to export. Pass -Maps=, -MapList= or -AllMaps."));
+        return 1;
+    }
+
+    FString OutputDirectory = FPaths::ProjectSavedDir() / TEXT("EditorActorTagDisplay") / TEXT("TagIndex");
+    FParse::Value(*Params, TEXT("Output="), OutputDirectory);
+    const bool bWriteJson = FParse::Param(*Params, TEXT("Json"));
+    const bool bAllowPartial = FParse::Param(*Params, TEXT("AllowPartial"));
+    int32 NumPrefetch = DefaultPrefetch;
+    int32 GCInterval = DefaultGCInterval;
+    FParse::Value(*Params, TEXT("Prefetch="), NumPrefetch);
+    FParse::Value(*Params, TEXT("GCInterval="), GCInterval);
+    NumPrefetch = FMath::Clamp(NumPrefetch, 0, MaxPrefetch);
+
+    // ブループリントのクラスは読み込まれるまで一致判定できないため、先にまとめて読み込む
+    // 処理済みのマップを解放するガベージコレクションで破棄されないよう、読み込んだクラスは保持する
+    TArray<FActorClassTagDisplayConfig> ClassConfigs = Settings->GetClassConfigs();
+    TArray<TStrongObjectPtr<UClass>> LoadedClasses;
+    for (FActorClassTagDisplayConfig &Config : ClassConfigs)
+    {
+        if (UClass *ActorClass = Config.ActorClass.LoadSynchronous())
+        {
+            LoadedClasses.Emplace(ActorClass);
+        }
+    }
+    FEditorActorTagDisplayConfigMatcher ConfigMatcher;
+
+    // 処理中のマップの後続を非同期に読み込み、読み込みと書き出しを重ねる
+    // 読み込み済みで未処理のマップは、ガベージコレクションで破棄されないよう処理するまで保持する
+    TArray<int32> LoadRequestIds;
+    LoadRequestIds.Init(INDEX_NONE, PackageNames.Num());
+    TArray<TStrongObjectPtr<UWorld>> LoadedWorlds;
+    LoadedWorlds.SetNum(PackageNames.Num());
+    const auto RequestLoad = [&PackageNames, &LoadRequestIds, &LoadedWorlds](int32 MapIndex) -> void
+    {
+        if (!LoadRequestIds.IsValidIndex(MapIndex) || LoadRequestIds[MapIndex] != INDEX_NONE)
+        {
+            return;
+        }
+
+        LoadRequestIds[MapIndex] = LoadPackageAsync(
+            PackageNames[MapIndex],
+            FLoadPackageAsyncDelegate::CreateLambda(
+                [&LoadedWorlds, MapIndex](const FName & /*PackageName*/, UPackage *Package,
+                                          EAsyncLoadingResult::Type /*Result*/) -> void
+                {
+                    if (Package != nullptr)
+                    {
+                        LoadedWorlds[MapIndex].Reset(UWorld::FindWorldInPackage(Package));
+                    }
+                }));
+    };
+
+    const TSharedRef<FJsonObject> Summary = MakeShared<FJsonObject>();
+    TArray<TSharedPtr<FJsonValue>> MapValues;
+    int32 NumFailedMaps = 0;
+    int32 NumPartialMaps = 0;
+    int32 NumExportedActors = 0;
+    const double StartTime = FPlatformTime::Seconds();
+
+    for (int32 MapIndex = 0; MapIndex < PackageNames.Num(); ++MapIndex)
+    {
+        for (int32 PrefetchIndex = MapIndex; PrefetchIndex <= MapIndex + NumPrefetch; ++PrefetchIndex)
+        {
+            RequestLoad(PrefetchIndex);
+        }
+        FlushAsyncLoading(LoadRequestIds[MapIndex]);
+
+        const FString &PackageName = PackageNames[MapIndex];
+        UWorld *World = LoadedWorlds[MapIndex].Get();
+        const int32 NumActors =
+            World != nullptr ? UEditorActorTagDisplayTagIndexExportCommandlet::ExportWorld(
+                                   World, PackageName, ConfigMatcher, ClassConfigs, OutputDirectory, bWriteJson)
+                             : INDEX_NONE;
+        // World Partitionのマップは常時読み込みでないアクターが含まれないため、成功ではなく部分的な結果として報告する
+        const bool bIsPartial = NumActors != INDEX_NONE && World->IsPartitionedWorld();
+        if (World != nullptr)
+        {
+            ClearStandaloneFlags(World);
+        }
+        LoadedWorlds[MapIndex].Reset();
+
+        const TSharedRef<FJsonObject> MapObject = MakeShared<FJsonObject>();
+        MapObject->SetStringField(TEXT("Map"), PackageName);
+        MapObject->SetStringField(TEXT("Index"), GetIndexFileBaseName(PackageName));
+        MapObject->SetNumberField(TEXT("NumActors"), FMath::Max(NumActors, 0));
+        MapObject->SetBoolField(TEXT("Succeeded"), NumActors != INDEX_NONE && !bIsPartial);
+        MapObject->SetBoolField(TEXT("Partial"), bIsPartial);
+        MapValues.Add(MakeShared<FJsonValueObject>(MapObject));
+
+        if (NumActors == INDEX_NONE)
+        {
+            ++NumFailedMaps;
+            // NOLINTNEXTLINE
+            UE_LOG(LogEditorActorTagDisplay, Error, TEXT("[%d/%d] Failed to export %s"), MapIndex + 1,
+                   PackageNames.Num(), *PackageName);
+        }
+        else if (bIsPartial)
+        {
+            ++NumPartialMaps;
+            NumExportedActors += NumActors;
+            // NOLINTNEXTLINE
+            UE_LOG(LogEditorActorTagDisplay, Warning,
+                   TEXT("[%d/%d] Exported %d tagged actors from %s, which uses World Partition; actors that are not "
+                        "always loaded are missing from the index"),
+                   MapIndex + 1, PackageNames.Num(), NumActors, *PackageName);
+        }
+        else
+        {
+            NumExportedActors += NumActors;
+            // NOLINTNEXTLINE
+            UE_LOG(LogEditorActorTagDisplay, Display, TEXT("[%d/%d] Exported %d tagged actors from %s"), MapIndex + 1,
+                   PackageNames.Num(), NumActors, *PackageName);
+        }
+
+        // 数百のマップを1プロセスで処理できるよう、処理済みのマップを定期的に解放する
+        if (GCInterval > 0 && (MapIndex + 1) % GCInterval == 0)
+        {
+            CollectGarbage(RF_NoFlags);
+
+            // 解放されたクラスのアドレスが再利用されても誤った一致判定をしないよう、クラスごとのキャッシュを破棄する
+            ConfigMatcher.Reset();
+        }
+    }
+
+    Summary->SetNumberField(TEXT("NumMaps"), PackageNames.Num());
+    Summary->SetNumberField(TEXT("NumFailedMaps"), NumFailedMaps);
+    Summary->SetNumberField(TEXT("NumPartialMaps"), NumPartialMaps);
+    Summary->SetNumberField(TEXT("NumActors"), NumExportedActors);
+    Summary->SetNumberField(TEXT("Seconds"), FPlatformTime::Seconds() - StartTime);
+    Summary->SetArrayField(TEXT("Maps"), MapValues);
+
+    FString SummaryJson;
+    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&SummaryJson);
+    FJsonSerializer::Serialize(Summary, Writer);
+
+    const FString SummaryPath = OutputDirectory / TEXT("Summary.json");
+    if (!FFileHelper::SaveStringToFile(SummaryJson, *SummaryPath))
+    {
+        // NOLINTNEXTLINE
+        UE_LOG(LogEditorActorTagDisplay, Error, TEXT("Failed to write tag index summary to %s"), *SummaryPath);
+        return 1;
+    }
+
+    // NOLINTNEXTLINE
+    UE_LOG(LogEditorActorTagDisplay, Display,
+           TEXT("Exported %d tagged actors from %d maps (%d failed, %d partial) to %s"), NumExportedActors,
+           PackageNames.Num() - NumFailedMaps, NumFailedMaps, NumPartialMaps, *OutputDirectory);
+    return NumFailedMaps == 0 && (NumPartialMaps == 0 || bAllowPartial) ? 0 : 1;
+}
+
+auto UEditorActorTagDisplayTagIndexExportCommandlet::ExportWorld(
+    UWorld *World, const FString &PackageName, FEditorActorTagDisplayConfigMatcher &ConfigMatcher,
+    const TArray<FActorClassTagDisplayConfig> &ClassConfigs, const FString &OutputDirectory, bool bWriteJson) -> int32
+{
+    // NOLINTNEXTLINE
+    check(World != nullptr);
+
+    // 基準位置にバウンディングボックスを使うため、コンポーネントを登録する（描画・物理・ナビゲーションは作らない）
+    const bool bWasInitialized = World->bIsWorldInitialized;
+    if (!bWasInitialized)
+    {
+        World->InitWorld(UWorld::InitializationValues()
+                             .InitializeScenes(false)
+                             .AllowAudioPlayback(false)
+                             .RequiresHitProxies(false)
+                             .CreatePhysicsScene(false)
+                             .CreateNavigation(false)
+                             .CreateAISystem(false)
+                             .ShouldSimulatePhysics(false)
+                             .EnableTraceCollision(false)
+                             .SetTransactional(false)
+                             .CreateFXSystems(false));
+    }
+    World->UpdateWorldComponents(true, false);
+
+    FMapTagIndex Index;
+    TArray<FName> Tags;
+    FString ValueText;
+    for (const ULevel *Level : World->GetLevels())
+    {
+        if (Level == nullptr)
+        {
+            continue;
+        }
+
+        for (const AActor *Actor : Level->Actors)
+        {
+            if (Actor == nullptr || !IsValid(Actor) || !ConfigMatcher.MayShowLabel(Actor, ClassConfigs))
+            {
+                continue;
+            }
+
+            // ラベルの表示と同じ規則で一致判定し、表示されるタグのみを書き出す
+            const int32 ConfigIndex = ConfigMatcher.MatchActor(Actor, ClassConfigs);
+            if (ConfigIndex == INDEX_NONE)
+            {
+                continue;
+            }
+
+            // プロパティの値の行はインデックスに含めず、タグとして表示される内容のみを書き出す
+            Tags.Reset();
+            ValueText.Reset();
+            ConfigMatcher.AppendLabelContent(Actor, ConfigIndex, ClassConfigs, Tags, ValueText);
+
+            FExportedActor &Exported = Index.Actors.AddDefaulted_GetRef();
+            Exported.ActorPath = Actor->GetPathName(World);
+            Exported.ClassIndex = Index.AddString(Actor->GetClass()->GetPathName());
+            Exported.ConfigIndex = ConfigIndex;
+            Exported.Anchor =
+                FVector3f(FEditorActorTagDisplayAnchorCache::ComputeAnchor(Actor, ClassConfigs[ConfigIndex]));
+            Exported.TagIndices.Reserve(Tags.Num());
+            for (const FName &Tag : Tags)
+            {
+                Exported.TagIndices.Add(Index.AddString(Tag.ToString()));
+            }
+        }
+    }
+
+    World->ClearWorldComponents();
+    if (!bWasInitialized)
+    {
+        World->CleanupWorld();
+    }
+
+    const FString BasePath = OutputDirectory / GetIndexFileBaseName(PackageName);
+    if (!WriteBinaryIndex(Index, BasePath + TEXT(".tagindex")))
+    {
+        return INDEX_NONE;
+    }
+    if (bWriteJson && !WriteJsonIndex(Index, PackageName, BasePath + TEXT(".json")))
+    {
+        return INDEX_NONE;
+    }
+    return Index.Actors.Num();
+}
@@ -0,0 +1,552 @@
+#include "EditorActorTagDisplayTagIndexSubsystem.h"
+#include "Editor.h"
+#include "Engine/Level.h"
+#include "Engine/Selection.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/TransactionObjectEvent.h"
+#include "UObject/UObjectGlobals.h"
+
+auto UEditorActorTagDisplayTagIndexSubsystem::Get() -> UEditorActorTagDisplayTagIndexSubsystem *
+{
+    return GEditor != nullptr ? GEditor->GetEditorSubsystem<UEditorActorTagDisplayTagIndexSubsystem>() : nullptr;
+}
+
+auto UEditorActorTagDisplayTagIndexSubsystem::Initialize(FSubsystemCollectionBase &Collection) -> void
+{
+    Super::Initialize(Collection);
+
+    if (GEngine != nullptr)
+    {
+        LevelActorAddedDelegateHandle = GEngine->OnLevelActorAdded().AddUObject(
+            this, &UEditorActorTagDisplayTagIndexSubsystem::OnLevelActorAdded);
+        LevelActorDeletedDelegateHandle = GEngine->OnLevelActorDeleted().AddUObject(
+            this, &UEditorActorTagDisplayTagIndexSubsystem::OnLevelActorDeleted);
+    }
+
+    ObjectPropertyChangedDelegateHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddUObject(
+        this, &UEditorActorTagDisplayTagIndexSubsystem::OnObjectPropertyChanged);
+    ObjectTransactedDelegateHandle = FCoreUObjectDelegates::OnObjectTransacted.AddUObject(
+        this, &UEditorActorTagDisplayTagIndexSubsystem::OnObjectTransacted);
+
+    // レベルストリーミング・World Partitionによるレベルの追加・削除
+    LevelAddedToWorldDelegateHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(
+        this, &UEditorActorTagDisplayTagIndexSubsystem::OnLevelAddedToWorld);
+    LevelRemovedFromWorldDelegateHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(
+        this, &UEditorActorTagDisplayTagIndexSubsystem::OnLevelRemovedFromWorld);
+    WorldCleanupDelegateHandle =
+        FWorldDelegates::OnWorldCleanup.AddUObject(this, &UEditorActorTagDisplayTagIndexSubsystem::OnWorldCleanup);
+}
+
+auto UEditorActorTagDisplayTagIndexSubsystem::Deinitialize() -> void
+{
+    if (GEngine != nullptr)
+    {
+        GEngine->OnLevelActorAdded().Remove(LevelActorAddedDelegateHandle);
+        GEngine->OnLevelActorDeleted().Remove(LevelActorDeletedDelegateHandle);
+    }
+
+    FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(ObjectPropertyChangedDelegateHandle);
+    FCoreUObjectDelegates::OnObjectTransacted.Remove(ObjectTransactedDelegateHandle);
+    FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedToWorldDelegateHandle);
+    FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedFromWorldDelegateHandle);
+    FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupDelegateHandle);
+
+    LevelActorAddedDelegateHandle.Reset();
+    LevelActorDeletedDelegateHandle.Reset();
+    ObjectPropertyChangedDelegateHandle.Reset();
+    ObjectTransactedDelegateHandle.Reset();
+    LevelAddedToWorldDelegateHandle.Reset();
+    LevelRemovedFromWorldDelegateHandle.Reset();
+    WorldCleanupDelegateHandle.Reset();
+
+    TArray<TObjectKey<UWorld>, TInlineAllocator<4>> WorldKeys;
+    WorldIndices.GetKeys(WorldKeys);
+    for (const TObjectKey<UWorld> &WorldKey : WorldKeys)
+    {
+        RemoveWorldIndex(WorldKey);
+    }
+
+    Super::Deinitialize();
+}
+
+TArray<AActor *> UEditorActorTagDisplayTagIndexSubsystem::FindActorsWithTag(FName Tag)
+{
+    TArray<AActor *> Actors;
+    FindActorsWithTagInWorld(UEditorActorTagDisplayTagIndexSubsystem::GetEditorWorld(), Tag, Actors);
+    return Actors;
+}
+
+int32 UEditorActorTagDisplayTagIndexSubsystem::CountActorsWithTag(FName Tag)
+{
+    return CountActorsWithTagInWorld(UEditorActorTagDisplayTagIndexSubsystem::GetEditorWorld(), Tag);
+}
+
+TArray<AActor *> UEditorActorTagDisplayTagIndexSubsystem::FindActorsWithAllTags(const TArray<FName> &Tags)
+{
+    TArray<AActor *> Actors;
+    FindActorsWithAllTagsInWorld(UEditorActorTagDisplayTagIndexSubsystem::GetEditorWorld(), Tags, Actors);
+    return Actors;
+}
+
+TArray<AActor *> UEditorActorTagDisplayTagIndexSubsystem::FindActorsWithAnyTag(const TArray<FName> &Tags)
+{
+    TArray<AActor *> Actors;
+    FindActorsWithAnyTagInWorld(UEditorActorTagDisplayTagIndexSubsystem::GetEditorWorld(), Tags, Actors);
+    return Actors;
+}
+
+TArray<FName> UEditorActorTagDisplayTagIndexSubsystem::GetAllTags()
+{
+    TArray<FName> Tags;
+    if (const FWorldTagIndex *Index = GetOrBuildWorldIndex(UEditorActorTagDisplayTagIndexSubsystem::GetEditorWorld()))
+    {
+        Index->ActorsByTag.GetKeys(Tags);
+    }
+    return Tags;
+}
+
+int32 UEditorActorTagDisplayTagIndexSubsystem::SelectActorsWithAllTags(const TArray<FName> &Tags, bool bFocusViewports)
+{
+    if (GEditor == nullptr)
+    {
+        return 0;
+    }
+
+    TArray<AActor *> Actors;
+    FindActorsWithAllTagsInWorld(UEditorActorTagDisplayTagIndexSubsystem::GetEditorWorld(), Tags, Actors);
+
+    // 選択変更の通知は最後に1回だけ行う
+    USelection *Selection = GEditor->GetSelectedActors();
+    Selection->BeginBatchSelectOperation();
+    GEditor->SelectNone(false, true, false);
+    for (AActor *Actor : Actors)
+    {
+        GEditor->SelectActor(Actor, true, false, true);
+    }
+    Selection->EndBatchSelectOperation(false);
+    GEditor->NoteSelectionChange();
+
+    if (bFocusViewports && !Actors.IsEmpty())
+    {
+        GEditor->MoveViewportCamerasToActor(Actors, false);
+    }
+    return Actors.Num();
+}
+
+auto UEditorActorTagDisplayTagIndexSubsystem::FindActorsWithTagInWorld(UWorld *World, FName Tag,
+                                                                       TArray<AActor *> &OutActors) -> void
+{
+    const FWorldTagIndex *Index = GetOrBuildWorldIndex(World);
+    const TSet<TWeakObjectPtr<AActor>> *Actors = Index != nullptr ? Index->ActorsByTag.Find(Tag) : nullptr;
+    if (Actors != nullptr)
+    {
+        OutActors.Reserve(OutActors.Num() + Actors->Num());
+        UEditorActorTagDisplayTagIndexSubsystem::AppendLiveActors(*Actors, Tag, OutActors);
+    }
+}
+
+auto UEditorActorTagDisplayTagIndexSubsystem::FindActorsWithAllTagsInWorld(UWorld *World, TConstArrayView<FName> Tags,
+                                                                           TArray<AActor *> &OutActors) -> void
+{
+    const FWorldTagIndex *Index = GetOrBuildWorldIndex(World);
+    if (Index == nullptr || Tags.IsEmpty())
+    {
+        return;
+    }
+
+    // 最も少ないタグの集合だけを走査し、残りのタグは候補ごとに確認する
+    const TSet<TWeakObjectPtr<AActor>> *SmallestActors = nullptr;
+    for (const FName &Tag : Tags)
+    {
+        const TSet<TWeakObjectPtr<AActor>> *Actors = Index->ActorsByTag.Find(Tag);
+        if (Actors == nullptr)
+        {
+            return;
+        }
+        if (SmallestActors == nullptr || Actors->Num() < SmallestActors->Num())
+        {
+            SmallestActors = Actors;
+        }
+    }
+
+    for (const TWeakObjectPtr<AActor> &WeakActor : *SmallestActors)
+    {
+        AActor *Actor = WeakActor.Get();
+        if (Actor == nullptr || !IsValid(Actor))
+        {
+            continue;
+        }
+
+        bool bHasAllTags = true;
+        for (const FName &Tag : Tags)
+        {
+            if (!Actor->Tags.Contains(Tag))
+            {
+                bHasAllTags = false;
+                break;
+            }
+        }
+        if (bHasAllTags)
+        {
+            OutActors.Add(Actor);
+        }
+    }
+}
+
+auto UEditorActorTagDisplayTagIndexSubsystem::FindActorsWithAnyTagInWorld(UWorld *World, TConstArrayView<FName> Tags,
+                                                                           TArray<AActor *> &OutActors) -> void
+{
+    const FWorldTagIndex *Index = GetOrBuildWorldIndex(World);
+    if (Index == nullptr)
+    {
+        return;
+    }
+
+    TArray<AActor *> TagActors;
+    TSet<AActor *> SeenActors;
+    for (const FName &Tag : Tags)
+    {
+        const TSet<TWeakObjectPtr<AActor>> *Actors = Index->ActorsByTag.Find(Tag);
+        if (Actors == nullptr)
+        {
+            continue;
+        }
+
+        TagActors.Reset();
+        UEditorActorTagDisplayTagIndexSubsystem::AppendLiveActors(*Actors, Tag, TagActors);
+        for (AActor *Actor : TagActors)
+        {
+            bool bIsAlreadyInSet = false;
+            SeenActors.Add(Actor, &bIsAlreadyInSet);
+            if (!bIsAlreadyInSet)
+            {
+                OutActors.Add(Actor);
+            }
+        }
+    }
+}
+
+auto UEditorActorTagDisplayTagIndexSubsystem::CountActorsWithTagInWorld(UWorld *World, FName Tag) -> int32
+{
+    // FindActorsWithTagと同じく生存とタグを確認し、結果の要素数と一致させる
+    const FWorldTagIndex *Index = GetOrBuildWorldIndex(World);
+    const TSet<TWeakObjectPtr<AActor>> *Actors = Index != nullptr ? Index->ActorsByTag.Find(Tag) : nullptr;
+    if (Actors == nullptr)
+    {
+        return 0;
+    }
+
+    int32 NumActors = 0;
+    for (const TWeakObjectPtr<AActor> &WeakActor : *Actors)
+    {
+        const AActor *Actor = WeakActor.Get();
+        if (Actor != nullptr && IsValid(Actor) && Actor->Tags.Contains(Tag))
+        {
+            ++NumActors;
+        }
+    }
+    return NumActors;
+}
+
+auto UEditorActorTagDisplayTagIndexSubsystem::GetEditorWorld() -> UWorld *
+{
+    return GEditor != nullptr ? GEditor->GetEditorWorldContext().World() : nullptr;
+}
+
+auto UEditorActorTagDisplayTagIndexSubsystem::GetOrBuildWorldIndex(UWorld *World) -> FWorldTagIndex *
+{
+    if (World == nullptr)
+    {
+        return nullptr;
+    }
+
+    if (FWorldTagIndex *Index = WorldIndices.Find(World))
+    {
+        return Index;
+    }
+
+    // 最初の問い合わせでのみワールド全体を走査し、以降はイベントで差分を反映する
+    FWorldTagIndex &Index = WorldIndices.Add(World);
+    for (ULevel *Level : World->GetLevels())
+    {
+        if (Level != nullptr)
+        {
+            IndexLevel(Index, Level);
+        }
+    }
+    return &Index;
+}
+
+auto UEditorActorTagDisplayTagIndexSubsystem::RemoveWorldIndex(const TObjectKey<UWorld> &WorldKey) -> void
+{
+    FWorldTagIndex *Index = WorldIndices.Find(WorldKey);
+    if (Index == nullptr)
+    {
+        return;
+    }
+
+    for (const auto &Pair : Index->IndexedLevels)
+    {
+        if (ULevel *Level = Pair.Value.Level.Get())
+        {
+            Level->OnLoadedActorAddedToLevelEvent.Remove(Pair.Value.LoadedActorAddedHandle);
+            Level->OnLoadedActorRemovedFromLevelEvent.Remove(Pair.Value.LoadedActorRemovedHandle);
+        }
+    }
+    WorldIndices.Remove(WorldKey);
+}
+
+auto UEditorActorTagDisplayTagIndexSubsystem::IndexLevel(FWorldTagIndex &Index, ULevel *Level) -> void
+{
+    // NOLINTNEXTLINE
+    check(Level != nullptr);
+
+    if (Index.IndexedLevels.Contains(Level))
+    {
+        return;
+    }
+
+    FIndexedLevel &IndexedLevel = Index.IndexedLevels.Add(Level);
+    IndexedLevel.Level = Level;
+    IndexedLevel.LoadedActorAddedHandle = Level->OnLoadedActorAddedToLevelEvent.AddUObject(
+        this, &UEditorActorTagDisplayTagIndexSubsystem::OnLoadedActorAdded);
+    IndexedLevel.LoadedActorRemovedHandle = Level->OnLoadedActorRemovedFromLevelEvent.AddUObject(
+        this, &UEditorActorTagDisplayTagIndexSubsystem::OnLoadedActorRemoved);
+
+    for (AActor *Actor : Level->Actors)
+    {
+        if (Actor != nullptr && !Actor->Tags.IsEmpty())
+        {
+            ReindexActor(Index, Actor);
+        }
+    }
+}
+
+auto UEditorActorTagDisplayTagIndexSubsystem::UnindexLevel(FWorldTagIndex &Index, const TObjectKey<ULevel> &LevelKey)
+    -> void
+{
+    FIndexedLevel *FoundLevel = Index.IndexedLevels.Find(LevelKey);
+    if (FoundLevel == nullptr)
+    {
+        return;
+    }
+    const FIndexedLevel IndexedLevel = MoveTemp(*FoundLevel);
+    Index.IndexedLevels.Remove(LevelKey);
+
+    if (ULevel *Level = IndexedLevel.Level.Get())
+    {
+        Level->OnLoadedActorAddedToLevelEvent.Remove(IndexedLevel.LoadedActorAddedHandle);
+        Level->OnLoadedActorRemovedFromLevelEvent.Remove(IndexedLevel.LoadedActorRemovedHandle);
+    }
+
+    // ワールド全体を走査せず、このレベルで索引に載せたアクターだけを外す
+    for (const TWeakObjectPtr<AActor> &Actor : IndexedLevel.Actors)
+    {
+        UnindexActor(Index, Actor);
+    }
+}
+
+auto UEditorActorTagDisplayTagIndexSubsystem::ReindexActor(AActor *Actor) -> void
+{
+    if (Actor == nullptr)
+    {
+        return;
+    }
+
+    // 索引を構築していないワールドのアクターは最初の問い合わせで走査される
+    if (FWorldTagIndex *Index = WorldIndices.Find(Actor->GetWorld()))
+    {
+        ReindexActor(*Index, Actor);
+    }
+}
+
+auto UEditorActorTagDisplayTagIndexSubsystem::ReindexActor(FWorldTagIndex &Index, AActor *Actor) -> void
+{
+    // NOLINTNEXTLINE
+    check(Actor != nullptr);
+
+    ULevel *Level = Actor->GetLevel();
+    if (!IsValid(Actor) || Level == nullptr || !Index.IndexedLevels.Contains(Level) || Actor->Tags.IsEmpty())
+    {
+        UnindexActor(Index, Actor);
+        return;
+    }
+
+    TArray<FName, TInlineAllocator<4>> NewTags;
+    for (const FName &Tag : Actor->Tags)
+    {
+        if (!Tag.IsNone())
+        {
+            NewTags.AddUnique(Tag);
+        }
+    }
+    if (NewTags.IsEmpty())
+    {
+        UnindexActor(Index, Actor);
+        return;
+    }
+
+    // 別のレベルへ移されたアクターは一度外してから載せ直す
+    FIndexedActor *IndexedActor = Index.IndexedActors.Find(Actor);
+    if (IndexedActor != nullptr && IndexedActor->Level != TObjectKey<ULevel>(Level))
+    {
+        UnindexActor(Index, Actor);
+        IndexedActor = nullptr;
+    }
+    if (IndexedActor == nullptr)
+    {
+        IndexedActor = &Index.IndexedActors.Add(Actor);
+        IndexedActor->Level = Level;
+        Index.IndexedLevels[Level].Actors.Add(Actor);
+    }
+
+    // 外れたタグと増えたタグの集合だけを更新する
+    for (const FName &Tag : IndexedActor->Tags)
+    {
+        if (NewTags.Contains(Tag))
+        {
+            continue;
+        }
+        if (TSet<TWeakObjectPtr<AActor>> *Actors = Index.ActorsByTag.Find(Tag))
+        {
+            Actors->Remove(Actor);
+            if (Actors->IsEmpty())
+            {
+                Index.ActorsByTag.Remove(Tag);
+            }
+        }
+    }
+    for (const FName &Tag : NewTags)
+    {
+        if (!IndexedActor->Tags.Contains(Tag))
+        {
+            Index.ActorsByTag.FindOrAdd(Tag).Add(Actor);
+        }
+    }
+    IndexedActor->Tags = MoveTemp(NewTags);
+}
+
+auto UEditorActorTagDisplayTagIndexSubsystem::UnindexActor(FWorldTagIndex &Index, const TWeakObjectPtr<AActor> &Actor)
+    -> void
+{
+    FIndexedActor IndexedActor;
+    if (!Index.IndexedActors.RemoveAndCopyValue(Actor, IndexedActor))
+    {
+        return;
+    }
+
+    for (const FName &Tag : IndexedActor.Tags)
+    {
+        if (TSet<TWeakObjectPtr<AActor>> *Actors = Index.ActorsByTag.Find(Tag))
+        {
+            Actors->Remove(Actor);
+            if (Actors->IsEmpty())
+            {
+                Index.ActorsByTag.Remove(Tag);
+            }
+        }
+    }
+    if (FIndexedLevel *IndexedLevel = Index.IndexedLevels.Find(IndexedActor.Level))
+    {
+        IndexedLevel->Actors.Remove(Actor);
+    }
+}
+
+auto UEditorActorTagDisplayTagIndexSubsystem::AppendLiveActors(const TSet<TWeakObjectPtr<AActor>> &Actors, FName Tag,
+                                                               TArray<AActor *> &OutActors) -> void
+{
+    // 通知なしにタグが書き換えられた場合に備え、結果に含める前に実際のタグを確認する
+    for (const TWeakObjectPtr<AActor> &WeakActor : Actors)
+    {
+        AActor *Actor = WeakActor.Get();
+        if (Actor != nullptr && IsValid(Actor) && Actor->Tags.Contains(Tag))
+        {
+            OutActors.Add(Actor);
+        }
+    }
+}
+
+auto UEditorActorTagDisplayTagIndexSubsystem::OnLevelActorAdded(AActor *Actor) -> void
+{
+    ReindexActor(Actor);
+}
+
+auto UEditorActorTagDisplayTagIndexSubsystem::OnLevelActorDeleted(AActor *Actor) -> void
+{
+    FWorldTagIndex *Index = Actor != nullptr ? WorldIndices.Find(Actor->GetWorld()) : nullptr;
+    if (Index != nullptr)
+    {
+        UnindexActor(*Index, Actor);
+    }
+}
+
+auto UEditorActorTagDisplayTagIndexSubsystem::OnObjectPropertyChanged(UObject *Object,
+                                                                      FPropertyChangedEvent &PropertyChangedEvent)
+    -> void
+{
+    // プロパティを指定しない変更通知ではタグが変わったかどうか分からないため再評価する
+    const FName MemberPropertyName = PropertyChangedEvent.GetMemberPropertyName();
+    if (MemberPropertyName == GET_MEMBER_NAME_CHECKED(AActor, Tags) || MemberPropertyName.IsNone())
+    {
+        ReindexActor(Cast<AActor>(Object));
+    }
+}
+
+auto UEditorActorTagDisplayTagIndexSubsystem::OnObjectTransacted(UObject *Object,
+                                                                 const FTransactionObjectEvent &TransactionEvent)
+    -> void
+{
+    // アンドゥ・リドゥではタグと生存状態のどちらも変わり得る
+    if (TransactionEvent.GetEventType() == ETransactionObjectEventType::UndoRedo)
+    {
+        ReindexActor(Cast<AActor>(Object));
+    }
+}
+
+auto UEditorActorTagDisplayTagIndexSubsystem::OnLevelAddedToWorld(ULevel *Level, UWorld *World) -> void
+{
+    FWorldTagIndex *Index = WorldIndices.Find(World);
+    if (Level != nullptr && Index != nullptr)
+    {
+        IndexLevel(*Index, Level);
+    }
+}
+
+auto UEditorActorTagDisplayTagIndexSubsystem::OnLevelRemovedFromWorld(ULevel *Level, UWorld *World) -> void
+{
+    // レベルがnullptrの場合はワールド全体が破棄される
+    if (Level == nullptr)
+    {
+        RemoveWorldIndex(World);
+        return;
+    }
+
+    if (FWorldTagIndex *Index = WorldIndices.Find(World))
+    {
+        UnindexLevel(*Index, Level);
+    }
+}
+
+auto UEditorActorTagDisplayTagIndexSubsystem::OnLoadedActorAdded(AActor &Actor) -> void
+{
+    if (!Actor.Tags.IsEmpty())
+    {
+        ReindexActor(&Actor);
+    }
+}
+
+auto UEditorActorTagDisplayTagIndexSubsystem::OnLoadedActorRemoved(AActor &Actor) -> void
+{
+    // 読み込み解除されたアクターは破棄通知を経ずに消えるため、ここで索引から外す
+    if (FWorldTagIndex *Index = WorldIndices.Find(Actor.GetWorld()))
+    {
+        UnindexActor(*Index, &Actor);
+    }
+}
+
+auto UEditorActorTagDisplayTagIndexSubsystem::OnWorldCleanup(UWorld *World, bool /*bSessionEnded*/,
+                                                             bool /*bCleanupResources*/) -> void
+{
+    RemoveWorldIndex(World);
+}
@@ -0,0 +1,41 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "EditorActorTagDisplayBenchmarkCommandlet.h"
+#include "Dom/JsonObject.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEditorActorTagDisplayBenchmarkTest, "Plugins.EditorActorTagDisplay.Benchmark",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+auto FEditorActorTagDisplayBenchmarkTest::RunTest(const FString & /*Parameters*/) -> bool
+{
+    // コマンドレットと同じ計測を規模を絞って実行する（大規模な計測はコマンドレットで行う）
+    constexpr int32 NumActors = 1000;
+    constexpr int32 NumTicks = 8;
+    const TSharedPtr<FJsonObject> Report = UEditorActorTagDisplayBenchmarkCommandlet::RunBenchmark(
+        TArray<int32>{NumActors}, UEditorActorTagDisplayBenchmarkCommandlet::DefaultNumConfigs, NumTicks);
+    if (!TestTrue(TEXT("The benchmark runs"), Report.IsValid()))
+    {
+        return false;
+    }
+
+    const TArray<TSharedPtr<FJsonValue>> &Scenarios = Report->GetArrayField(TEXT("Scenarios"));
+    if (!TestEqual(TEXT("One scenario is reported"), Scenarios.Num(), 1))
+    {
+        return false;
+    }
+
+    const TSharedPtr<FJsonObject> Scenario = Scenarios[0]->AsObject();
+    const int32 NumLabels = static_cast<int32>(Scenario->GetNumberField(TEXT("NumLabels")));
+    TestEqual(TEXT("The scenario covers every actor"), static_cast<int32>(Scenario->GetNumberField(TEXT("NumActors"))),
+              NumActors);
+    TestTrue(TEXT("Labels are created"), NumLabels > 0 && NumLabels <= NumActors);
+    TestTrue(TEXT("Tick times are measured"), Scenario->GetNumberField(TEXT("MeanTickMs")) >= 0.0);
+
+    AddInfo(FString::Printf(TEXT("%d labels, mean %.3f ms, p99 %.3f ms"), NumLabels,
+                            Scenario->GetNumberField(TEXT("MeanTickMs")), Scenario->GetNumberField(TEXT("P99TickMs"))));
+    return true;
+}
+
+#endif
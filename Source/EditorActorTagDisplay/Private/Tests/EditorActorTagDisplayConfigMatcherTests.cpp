@@ -0,0 +1,149 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "EditorActorTagDisplayConfigMatcher.h"
+#include "EditorActorTagDisplaySettings.h"
+#include "EditorActorTagDisplayTestWorld.h"
+#include "Components/SceneComponent.h"
+#include "Engine/TargetPoint.h"
+#include "Engine/TriggerBase.h"
+#include "Engine/TriggerBox.h"
+#include "Engine/TriggerSphere.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEditorActorTagDisplayConfigMatcherClassTest,
+                                 "Plugins.EditorActorTagDisplay.ConfigMatcher.ClassOrder",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+auto FEditorActorTagDisplayConfigMatcherClassTest::RunTest(const FString & /*Parameters*/) -> bool
+{
+    TArray<FActorClassTagDisplayConfig> ClassConfigs;
+    ClassConfigs.AddDefaulted_GetRef().ActorClass = ATriggerBox::StaticClass();
+    ClassConfigs.AddDefaulted_GetRef().ActorClass = ATriggerBase::StaticClass();
+    ClassConfigs.AddDefaulted_GetRef().ActorClass = ATriggerSphere::StaticClass();
+
+    FEditorActorTagDisplayConfigMatcher ConfigMatcher;
+    TestEqual(TEXT("The exact class matches"),
+              ConfigMatcher.FindConfigIndex(ATriggerBox::StaticClass(), ClassConfigs), 0);
+    TestEqual(TEXT("The first config of a base class wins over later ones"),
+              ConfigMatcher.FindConfigIndex(ATriggerSphere::StaticClass(), ClassConfigs), 1);
+    TestEqual(TEXT("Unrelated classes do not match"),
+              ConfigMatcher.FindConfigIndex(ATargetPoint::StaticClass(), ClassConfigs),
+              static_cast<int32>(INDEX_NONE));
+
+    // 設定を変えても、Resetするまではキャッシュした結果を返す
+    ClassConfigs.RemoveAt(0);
+    TestEqual(TEXT("Lookups are cached until Reset"),
+              ConfigMatcher.FindConfigIndex(ATriggerSphere::StaticClass(), ClassConfigs), 1);
+    ConfigMatcher.Reset();
+    TestEqual(TEXT("Reset drops cached lookups"),
+              ConfigMatcher.FindConfigIndex(ATriggerSphere::StaticClass(), ClassConfigs), 0);
+    TestEqual(TEXT("Unrelated classes still do not match"),
+              ConfigMatcher.FindConfigIndex(ATargetPoint::StaticClass(), ClassConfigs),
+              static_cast<int32>(INDEX_NONE));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEditorActorTagDisplayConfigMatcherActorTest,
+                                 "Plugins.EditorActorTagDisplay.ConfigMatcher.MatchActor",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+auto FEditorActorTagDisplayConfigMatcherActorTest::RunTest(const FString & /*Parameters*/) -> bool
+{
+    FEditorActorTagDisplayTestWorld TestWorld;
+    ATargetPoint *Shown = TestWorld.SpawnActor<ATargetPoint>({TEXT("ShowMe"), TEXT("Other")});
+    ATargetPoint *Filtered = TestWorld.SpawnActor<ATargetPoint>({TEXT("Other")});
+    ATargetPoint *Untagged = TestWorld.SpawnActor<ATargetPoint>();
+    ATriggerBox *Unmatched = TestWorld.SpawnActor<ATriggerBox>({TEXT("ShowMe")});
+    if (!TestNotNull(TEXT("Actors are spawned"), Shown) || !TestNotNull(TEXT("Actors are spawned"), Filtered) ||
+        !TestNotNull(TEXT("Actors are spawned"), Untagged) || !TestNotNull(TEXT("Actors are spawned"), Unmatched))
+    {
+        return false;
+    }
+
+    TArray<FActorClassTagDisplayConfig> ClassConfigs;
+    FActorClassTagDisplayConfig &Config = ClassConfigs.AddDefaulted_GetRef();
+    Config.ActorClass = ATargetPoint::StaticClass();
+    Config.IncludeTagPatterns = {TEXT("Show*")};
+
+    FEditorActorTagDisplayConfigMatcher ConfigMatcher;
+    TestEqual(TEXT("Actors with a passing tag match"), ConfigMatcher.MatchActor(Shown, ClassConfigs), 0);
+    TestEqual(TEXT("Actors without a passing tag do not match"), ConfigMatcher.MatchActor(Filtered, ClassConfigs),
+              static_cast<int32>(INDEX_NONE));
+    TestEqual(TEXT("Actors of unmatched classes do not match"), ConfigMatcher.MatchActor(Unmatched, ClassConfigs),
+              static_cast<int32>(INDEX_NONE));
+    TestTrue(TEXT("Tagged actors of matched classes are candidates"), ConfigMatcher.MayShowLabel(Shown, ClassConfigs));
+    TestFalse(TEXT("Untagged actors are not candidates"), ConfigMatcher.MayShowLabel(Untagged, ClassConfigs));
+    TestFalse(TEXT("Unmatched classes are not candidates"), ConfigMatcher.MayShowLabel(Unmatched, ClassConfigs));
+
+    TArray<FName> Tags;
+    FString ValueText;
+    TestEqual(TEXT("Actor tags produce no value lines"),
+              ConfigMatcher.AppendLabelContent(Shown, 0, ClassConfigs, Tags, ValueText), 0);
+    TestTrue(TEXT("Only passing tags are appended"), Tags == TArray<FName>{TEXT("ShowMe")});
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEditorActorTagDisplayConfigMatcherSourcesTest,
+                                 "Plugins.EditorActorTagDisplay.ConfigMatcher.LabelSources",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+auto FEditorActorTagDisplayConfigMatcherSourcesTest::RunTest(const FString & /*Parameters*/) -> bool
+{
+    FEditorActorTagDisplayTestWorld TestWorld;
+    ATargetPoint *Actor = TestWorld.SpawnActor<ATargetPoint>();
+    if (!TestNotNull(TEXT("Actor is spawned"), Actor) ||
+        !TestNotNull(TEXT("Actor has a root"), Actor->GetRootComponent()))
+    {
+        return false;
+    }
+    Actor->GetRootComponent()->ComponentTags = {TEXT("FromComponent")};
+    Actor->InitialLifeSpan = 5.0F;
+
+    TArray<FActorClassTagDisplayConfig> ClassConfigs;
+    FActorClassTagDisplayConfig &Config = ClassConfigs.AddDefaulted_GetRef();
+    Config.ActorClass = ATargetPoint::StaticClass();
+    FEditorActorTagDisplayLabelSource &ComponentSource = Config.LabelSources.AddDefaulted_GetRef();
+    ComponentSource.SourceType = EEditorActorTagDisplayLabelSourceType::ComponentTags;
+    FEditorActorTagDisplayLabelSource &PropertySource = Config.LabelSources.AddDefaulted_GetRef();
+    PropertySource.SourceType = EEditorActorTagDisplayLabelSourceType::Property;
+    PropertySource.PropertyPath = TEXT("InitialLifeSpan");
+
+    FEditorActorTagDisplayConfigMatcher ConfigMatcher;
+    TestTrue(TEXT("Actors without tags are candidates with extra sources"),
+             ConfigMatcher.MayShowLabel(Actor, ClassConfigs));
+    TestEqual(TEXT("Component tags make the actor match"), ConfigMatcher.MatchActor(Actor, ClassConfigs), 0);
+
+    TArray<FName> Tags;
+    FString ValueText;
+    TestEqual(TEXT("Property sources produce one value line"),
+              ConfigMatcher.AppendLabelContent(Actor, 0, ClassConfigs, Tags, ValueText), 1);
+    TestTrue(TEXT("Component tags are appended"), Tags == TArray<FName>{TEXT("FromComponent")});
+    TestTrue(TEXT("Values are prefixed with their path"), ValueText.StartsWith(TEXT("InitialLifeSpan: 5")));
+
+    // 文字列化した値は変更が通知されるまで使い回す
+    Actor->InitialLifeSpan = 7.0F;
+    Tags.Reset();
+    ValueText.Reset();
+    ConfigMatcher.AppendLabelContent(Actor, 0, ClassConfigs, Tags, ValueText);
+    TestTrue(TEXT("Formatted values are cached"), ValueText.StartsWith(TEXT("InitialLifeSpan: 5")));
+    ConfigMatcher.InvalidateValueText(Actor);
+    Tags.Reset();
+    ValueText.Reset();
+    ConfigMatcher.AppendLabelContent(Actor, 0, ClassConfigs, Tags, ValueText);
+    TestTrue(TEXT("Invalidated values are formatted again"), ValueText.StartsWith(TEXT("InitialLifeSpan: 7")));
+
+    // 解決できないパスは警告を出して無視する
+    Config.LabelSources.Last().PropertyPath = TEXT("NoSuchProperty");
+    ConfigMatcher.Reset();
+    AddExpectedMessage(TEXT("cannot be resolved"), ELogVerbosity::Warning, EAutomationExpectedMessageFlags::Contains,
+                       1, false);
+    Tags.Reset();
+    ValueText.Reset();
+    TestEqual(TEXT("Unresolved properties produce no value line"),
+              ConfigMatcher.AppendLabelContent(Actor, 0, ClassConfigs, Tags, ValueText), 0);
+    TestTrue(TEXT("Other sources are still read"), Tags == TArray<FName>{TEXT("FromComponent")});
+    return true;
+}
+
+#endif
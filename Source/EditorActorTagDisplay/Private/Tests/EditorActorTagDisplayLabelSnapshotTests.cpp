@@ -0,0 +1,102 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "EditorActorTagDisplayLabelSnapshot.h"
+#include "EditorActorTagDisplayConfigMatcher.h"
+#include "EditorActorTagDisplaySettings.h"
+#include "EditorActorTagDisplayTestWorld.h"
+#include "Engine/TargetPoint.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEditorActorTagDisplayLabelSnapshotHashTest,
+                                 "Plugins.EditorActorTagDisplay.LabelSnapshot.HashTags",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+auto FEditorActorTagDisplayLabelSnapshotHashTest::RunTest(const FString & /*Parameters*/) -> bool
+{
+    const TArray<FName> Tags = {TEXT("Alpha"), TEXT("Beta")};
+    const uint32 Hash = FEditorActorTagDisplayLabelSnapshot::HashTags(Tags);
+
+    TestEqual(TEXT("Equal tags hash equally"), FEditorActorTagDisplayLabelSnapshot::HashTags(TArray<FName>(Tags)),
+              Hash);
+    TestNotEqual(TEXT("Tag order changes the hash"),
+                 FEditorActorTagDisplayLabelSnapshot::HashTags(TArray<FName>{TEXT("Beta"), TEXT("Alpha")}), Hash);
+    TestNotEqual(TEXT("An added tag changes the hash"),
+                 FEditorActorTagDisplayLabelSnapshot::HashTags(TArray<FName>{TEXT("Alpha"), TEXT("Beta"), NAME_None}),
+                 Hash);
+    TestNotEqual(TEXT("The name number changes the hash"),
+                 FEditorActorTagDisplayLabelSnapshot::HashTags(TArray<FName>{FName(TEXT("Alpha"), 2), TEXT("Beta")}),
+                 Hash);
+
+#if WITH_CASE_PRESERVING_NAME
+    // 比較上は等しいFNameでも、表示が変わる大文字小文字の変更は検出する
+    const TArray<FName> UpperTags = {TEXT("ALPHA"), TEXT("Beta")};
+    TestTrue(TEXT("Case-only changes compare equal as names"), UpperTags == Tags);
+    TestNotEqual(TEXT("Case-only changes change the hash"), FEditorActorTagDisplayLabelSnapshot::HashTags(UpperTags),
+                 Hash);
+#endif
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEditorActorTagDisplayLabelSnapshotTextTest,
+                                 "Plugins.EditorActorTagDisplay.LabelSnapshot.Text",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+auto FEditorActorTagDisplayLabelSnapshotTextTest::RunTest(const FString & /*Parameters*/) -> bool
+{
+    FString Text;
+    FEditorActorTagDisplayLabelSnapshot::AppendTagsText(TArray<FName>{TEXT("Alpha"), TEXT("Beta")}, Text);
+    TestEqual(TEXT("Tags are joined one per line"), Text, FString(TEXT("Alpha\nBeta")));
+
+    Text.Reset();
+    FEditorActorTagDisplayLabelSnapshot::AppendTagsText(TArray<FName>(), Text);
+    TestTrue(TEXT("No tags produce no text"), Text.IsEmpty());
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEditorActorTagDisplayLabelSnapshotBuildTest,
+                                 "Plugins.EditorActorTagDisplay.LabelSnapshot.Build",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+auto FEditorActorTagDisplayLabelSnapshotBuildTest::RunTest(const FString & /*Parameters*/) -> bool
+{
+    FEditorActorTagDisplayTestWorld TestWorld;
+    ATargetPoint *Actor = TestWorld.SpawnActor<ATargetPoint>({TEXT("Show"), TEXT("Hidden"), TEXT("Other")});
+    if (!TestNotNull(TEXT("Actor is spawned"), Actor))
+    {
+        return false;
+    }
+
+    TArray<FActorClassTagDisplayConfig> ClassConfigs;
+    FActorClassTagDisplayConfig &Config = ClassConfigs.AddDefaulted_GetRef();
+    Config.ActorClass = ATargetPoint::StaticClass();
+    Config.ExcludeTagPatterns = {TEXT("Hidden")};
+    Config.PositionOffset = FVector(0.0, 0.0, 100.0);
+
+    FEditorActorTagDisplayConfigMatcher ConfigMatcher;
+    const TArray<FName> ShownTags = {TEXT("Show"), TEXT("Other")};
+    const uint32 ShownHash = FEditorActorTagDisplayLabelSnapshot::HashTags(ShownTags);
+    const FVector Anchor(10.0, 20.0, 30.0);
+
+    FEditorActorTagDisplayLabelSnapshot Snapshot;
+    const int32 NewIndex = Snapshot.Add(Actor, 0, ConfigMatcher, ClassConfigs, Anchor, Config.PositionOffset, 0, false);
+    const int32 KnownIndex =
+        Snapshot.Add(Actor, 0, ConfigMatcher, ClassConfigs, Anchor, Config.PositionOffset, ShownHash, true);
+    Snapshot.Build(FVector(1000.0, 0.0, 0.0));
+
+    TestEqual(TEXT("Both entries are snapshotted"), Snapshot.Num(), 2);
+    TestEqual(TEXT("Only shown tags are counted"), Snapshot.GetNumLines(NewIndex), 2);
+    TestEqual(TEXT("The hash covers the shown tags only"), Snapshot.GetTagsHash(NewIndex), ShownHash);
+    TestEqual(TEXT("Known and new entries hash equally"), Snapshot.GetTagsHash(KnownIndex), ShownHash);
+    TestEqual(TEXT("The text position adds the class offset"), Snapshot.GetTextPosition(NewIndex),
+              FVector(10.0, 20.0, 130.0));
+    TestEqual(TEXT("New entries get their text"), Snapshot.EnsureText(NewIndex), FString(TEXT("Show\nOther")));
+    TestEqual(TEXT("Known entries build their text on demand"), Snapshot.EnsureText(KnownIndex),
+              FString(TEXT("Show\nOther")));
+
+    Snapshot.Reset();
+    TestEqual(TEXT("Reset removes all entries"), Snapshot.Num(), 0);
+    return true;
+}
+
+#endif
@@ -0,0 +1,97 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "EditorActorTagDisplayLabelTable.h"
+#include "EditorActorTagDisplayTestWorld.h"
+#include "Engine/TargetPoint.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEditorActorTagDisplayLabelTableSlotsTest,
+                                 "Plugins.EditorActorTagDisplay.LabelTable.Slots",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+auto FEditorActorTagDisplayLabelTableSlotsTest::RunTest(const FString & /*Parameters*/) -> bool
+{
+    FEditorActorTagDisplayTestWorld TestWorld;
+    AActor *First = TestWorld.SpawnActor<ATargetPoint>();
+    AActor *Second = TestWorld.SpawnActor<ATargetPoint>();
+    AActor *Third = TestWorld.SpawnActor<ATargetPoint>();
+    if (!TestNotNull(TEXT("Actors are spawned"), First) || !TestNotNull(TEXT("Actors are spawned"), Second) ||
+        !TestNotNull(TEXT("Actors are spawned"), Third))
+    {
+        return false;
+    }
+
+    FEditorActorTagDisplayLabelTable Labels;
+    const int32 FirstHandle = Labels.FindOrAdd(First);
+    const int32 SecondHandle = Labels.FindOrAdd(Second);
+    TestEqual(TEXT("Labels are counted"), Labels.Num(), 2);
+    TestEqual(TEXT("FindOrAdd returns the existing label"), Labels.FindOrAdd(First), FirstHandle);
+    TestEqual(TEXT("Find returns the label of the actor"), Labels.Find(Second), SecondHandle);
+    TestEqual(TEXT("Find returns INDEX_NONE without a label"), Labels.Find(Third), static_cast<int32>(INDEX_NONE));
+
+    Labels.SetTextHash(SecondHandle, 42);
+    Labels.GetEntry(SecondHandle).bIsFingerprintValid = true;
+    Labels.Remove(FirstHandle);
+    TestFalse(TEXT("Removed handles are invalid"), Labels.IsValidHandle(FirstHandle));
+    TestFalse(TEXT("Removed actors have no label"), Labels.Contains(First));
+    TestEqual(TEXT("Other labels keep their handle"), Labels.Find(Second), SecondHandle);
+    TestEqual(TEXT("Other labels keep their state"), Labels.GetTextHash(SecondHandle), 42U);
+
+    // 空きスロットは再利用され、以前の状態を引き継がない
+    const int32 ThirdHandle = Labels.FindOrAdd(Third);
+    TestEqual(TEXT("Freed slots are reused"), ThirdHandle, FirstHandle);
+    TestEqual(TEXT("Reused slots start with a cleared hash"), Labels.GetTextHash(ThirdHandle), 0U);
+    TestFalse(TEXT("Reused slots start without a fingerprint"), Labels.GetEntry(ThirdHandle).bIsFingerprintValid);
+
+    // 破棄されたアクターも、解決せずにインデックスとシリアル番号で見つけられる
+    const TWeakObjectPtr<AActor> WeakSecond = Second;
+    TestWorld.GetWorld()->DestroyActor(Second);
+    TestEqual(TEXT("Destroyed actors are still found"), Labels.Find(WeakSecond), SecondHandle);
+
+    Labels.Reset();
+    TestEqual(TEXT("Reset removes all labels"), Labels.Num(), 0);
+    TestFalse(TEXT("Reset removes the lookup"), Labels.Contains(Third));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEditorActorTagDisplayLabelTableSweepTest,
+                                 "Plugins.EditorActorTagDisplay.LabelTable.Sweep",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+auto FEditorActorTagDisplayLabelTableSweepTest::RunTest(const FString & /*Parameters*/) -> bool
+{
+    FEditorActorTagDisplayTestWorld TestWorld;
+    AActor *Kept = TestWorld.SpawnActor<ATargetPoint>();
+    AActor *Stale = TestWorld.SpawnActor<ATargetPoint>();
+    AActor *Added = TestWorld.SpawnActor<ATargetPoint>();
+    if (!TestNotNull(TEXT("Actors are spawned"), Kept) || !TestNotNull(TEXT("Actors are spawned"), Stale) ||
+        !TestNotNull(TEXT("Actors are spawned"), Added))
+    {
+        return false;
+    }
+
+    FEditorActorTagDisplayLabelTable Labels;
+    const int32 KeptHandle = Labels.FindOrAdd(Kept);
+    const int32 StaleHandle = Labels.FindOrAdd(Stale);
+
+    // 再度見つかったラベルと、パス中に追加されたラベルだけが残る
+    Labels.BeginPass();
+    TestTrue(TEXT("MarkSeen finds labelled actors"), Labels.MarkSeen(Kept));
+    TestFalse(TEXT("MarkSeen ignores actors without a label"), Labels.MarkSeen(Added));
+    const int32 AddedHandle = Labels.FindOrAdd(Added);
+
+    TArray<int32> SweptHandles;
+    Labels.SweepUnseen([&SweptHandles](int32 Handle) -> void { SweptHandles.Add(Handle); });
+    TestTrue(TEXT("Only the unseen label is swept"), SweptHandles == TArray<int32>{StaleHandle});
+    TestTrue(TEXT("Seen labels are kept"), Labels.IsValidHandle(KeptHandle));
+    TestTrue(TEXT("Labels added during the pass are kept"), Labels.IsValidHandle(AddedHandle));
+    TestFalse(TEXT("Swept labels are removed"), Labels.Contains(Stale));
+
+    int32 NumVisited = 0;
+    Labels.ForEachLabel([&NumVisited](int32 /*Handle*/) -> void { ++NumVisited; });
+    TestEqual(TEXT("ForEachLabel skips free slots"), NumVisited, 2);
+    return true;
+}
+
+#endif
@@ -0,0 +1,66 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "EditorActorTagDisplayTagFilter.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEditorActorTagDisplayTagFilterEmptyTest,
+                                 "Plugins.EditorActorTagDisplay.TagFilter.Empty",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+auto FEditorActorTagDisplayTagFilterEmptyTest::RunTest(const FString & /*Parameters*/) -> bool
+{
+    FEditorActorTagDisplayTagFilter Filter;
+    TestTrue(TEXT("Filter without rules is empty"), Filter.IsEmpty());
+    TestTrue(TEXT("Empty filter passes any tag"), Filter.PassesTag(TEXT("Anything")));
+    TestFalse(TEXT("Empty filter rejects an actor without tags"), Filter.PassesAny(TArray<FName>()));
+
+    const TArray<FName> Tags = {TEXT("B"), TEXT("A")};
+    TArray<FName> Passing;
+    TestEqual(TEXT("Empty filter appends every tag"), Filter.AppendPassingTags(Tags, Passing), 2);
+    TestTrue(TEXT("Empty filter keeps the tag order"), Passing == Tags);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEditorActorTagDisplayTagFilterPatternsTest,
+                                 "Plugins.EditorActorTagDisplay.TagFilter.Patterns",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+auto FEditorActorTagDisplayTagFilterPatternsTest::RunTest(const FString & /*Parameters*/) -> bool
+{
+    {
+        FEditorActorTagDisplayTagFilter Filter(TArray<FString>{TEXT("Enemy")}, TArray<FString>());
+        TestTrue(TEXT("Exact include passes the tag"), Filter.PassesTag(TEXT("Enemy")));
+        TestTrue(TEXT("Exact include is case-insensitive"), Filter.PassesTag(TEXT("enemy")));
+        TestFalse(TEXT("Exact include rejects other tags"), Filter.PassesTag(TEXT("Ally")));
+    }
+    {
+        FEditorActorTagDisplayTagFilter Filter(TArray<FString>{TEXT("Spawn*")}, TArray<FString>());
+        TestTrue(TEXT("Prefix include passes a matching tag"), Filter.PassesTag(TEXT("SpawnPoint")));
+        TestTrue(TEXT("Prefix include passes the bare prefix"), Filter.PassesTag(TEXT("Spawn")));
+        TestFalse(TEXT("Prefix include only matches at the start"), Filter.PassesTag(TEXT("Respawn")));
+        TestTrue(TEXT("Cached decisions are reused"), Filter.PassesTag(TEXT("SpawnPoint")));
+    }
+    {
+        FEditorActorTagDisplayTagFilter Filter(TArray<FString>{TEXT("?oo*")}, TArray<FString>());
+        TestTrue(TEXT("Wildcard include passes a matching tag"), Filter.PassesTag(TEXT("Food")));
+        TestFalse(TEXT("Wildcard include rejects a non-matching tag"), Filter.PassesTag(TEXT("Flood")));
+    }
+    {
+        FEditorActorTagDisplayTagFilter Filter(TArray<FString>{TEXT("*")},
+                                               TArray<FString>{TEXT("Hidden"), TEXT("Debug*")});
+        TestTrue(TEXT("Include all passes regular tags"), Filter.PassesTag(TEXT("Visible")));
+        TestFalse(TEXT("Exact exclude wins over include"), Filter.PassesTag(TEXT("Hidden")));
+        TestFalse(TEXT("Prefix exclude wins over include"), Filter.PassesTag(TEXT("DebugOnly")));
+
+        const TArray<FName> Tags = {TEXT("Hidden"), TEXT("B"), TEXT("DebugOnly"), TEXT("A")};
+        TArray<FName> Passing;
+        TestEqual(TEXT("Only passing tags are appended"), Filter.AppendPassingTags(Tags, Passing), 2);
+        TestTrue(TEXT("Passing tags keep their order"), Passing == TArray<FName>{TEXT("B"), TEXT("A")});
+        TestTrue(TEXT("PassesAny finds a passing tag"), Filter.PassesAny(Tags));
+        TestFalse(TEXT("PassesAny rejects excluded tags only"), Filter.PassesAny(TArray<FName>{TEXT("Hidden")}));
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,49 @@
+#pragma once
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "CoreMinimal.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+// 自動テスト用の一時エディタワールド（破棄時にワールドも破棄する）
+class FEditorActorTagDisplayTestWorld
+{
+public:
+    UE_NONCOPYABLE(FEditorActorTagDisplayTestWorld);
+
+    FEditorActorTagDisplayTestWorld()
+    {
+        World = UWorld::CreateWorld(EWorldType::Editor, false, TEXT("EditorActorTagDisplayTest"));
+        GEngine->CreateNewWorldContext(EWorldType::Editor).SetCurrentWorld(World);
+    }
+
+    ~FEditorActorTagDisplayTestWorld()
+    {
+        GEngine->DestroyWorldContext(World);
+        World->DestroyWorld(false);
+    }
+
+    auto GetWorld() const -> UWorld * { return World; }
+
+    /** 指定したタグを持つアクターを生成する */
+    template <typename ActorType> auto SpawnActor(TArray<FName> Tags = {}) -> ActorType *
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        SpawnParams.ObjectFlags = RF_Transient;
+
+        ActorType *Actor = World->SpawnActor<ActorType>(SpawnParams);
+        if (Actor != nullptr)
+        {
+            Actor->Tags = MoveTemp(Tags);
+        }
+        return Actor;
+    }
+
+private:
+    UWorld *World = nullptr;
+};
+
+#endif
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+
+// 前方宣言
+class AActor;
+struct FActorClassTagDisplayConfig;
+
+// アクターごとのラベルの基準位置（クラスごとのオフセット適用前）のキャッシュ
+// コンポーネントのトランスフォーム更新か、明示的な無効化まで再計算しない
+class EDITORACTORTAGDISPLAY_API FEditorActorTagDisplayAnchorCache
+{
+public:
+    /** トランスフォーム更新で基準位置が無効化された時の通知 */
+    DECLARE_DELEGATE_OneParam(FOnAnchorInvalidated, AActor *);
+
+    FEditorActorTagDisplayAnchorCache() = default;
+    ~FEditorActorTagDisplayAnchorCache();
+
+    FEditorActorTagDisplayAnchorCache(const FEditorActorTagDisplayAnchorCache &) = delete;
+    auto operator=(const FEditorActorTagDisplayAnchorCache &) -> FEditorActorTagDisplayAnchorCache & = delete;
+
+    /** 基準位置を取得する（キャッシュできない求め方の場合は毎回計算する） */
+    auto GetAnchor(AActor *Actor, const FActorClassTagDisplayConfig &Config) -> FVector;
+
+    // 無効化・削除
+    auto Invalidate(const TWeakObjectPtr<AActor> &Actor) -> bool;
+    auto InvalidateAll() -> void;
+    auto Remove(const TWeakObjectPtr<AActor> &Actor) -> void;
+    auto Reset() -> void;
+
+    /** 基準位置をキャッシュしているかどうか（無効化済みを含む） */
+    auto Contains(const TWeakObjectPtr<AActor> &Actor) const -> bool { return Entries.Contains(Actor); }
+
+    auto GetOnAnchorInvalidated() -> FOnAnchorInvalidated & { return OnAnchorInvalidated; }
+
+    // 基準位置の計算
+    [[nodiscard]] static auto ComputeAnchor(const AActor *Actor, const FActorClassTagDisplayConfig &Config) -> FVector;
+    [[nodiscard]] static auto GetBoundsTopCenter(const FBox &Bounds, const FVector &Fallback) -> FVector;
+
+    /** 求め方の入力の変化をすべて検出できる場合のみキャッシュする */
+    [[nodiscard]] static auto CanCacheAnchor(const AActor *Actor, const FActorClassTagDisplayConfig &Config) -> bool;
+
+private:
+    /** TransformUpdatedを購読しているコンポーネント */
+    struct FBoundComponent
+    {
+        TWeakObjectPtr<USceneComponent> Component;
+        FDelegateHandle TransformUpdatedHandle;
+    };
+
+    struct FEntry
+    {
+        FVector Anchor = FVector::ZeroVector;
+        bool bIsValid = false;
+        TArray<FBoundComponent, TInlineAllocator<4>> BoundComponents;
+    };
+
+    // トランスフォーム更新の購読
+    auto BindTransformUpdated(FEntry &Entry, AActor *Actor, const FActorClassTagDisplayConfig &Config) -> void;
+    static auto UnbindTransformUpdated(FEntry &Entry) -> void;
+    auto OnTransformUpdated(USceneComponent *UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags,
+                            ETeleportType Teleport) -> void;
+
+    TMap<TWeakObjectPtr<AActor>, FEntry> Entries;
+    FOnAnchorInvalidated OnAnchorInvalidated;
+};
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "EditorActorTagDisplayBatchComponent.h"
+#include "EditorActorTagDisplayBatchActor.generated.h"
+
+// バッチ描画のコンポーネントを1つだけ持つ一時アクター（バッチ描画時にワールドごとに1つ生成する）
+UCLASS(Transient, NotPlaceable)
+class EDITORACTORTAGDISPLAY_API AEditorActorTagDisplayBatchActor : public AActor
+{
+    // NOLINTNEXTLINE
+    GENERATED_BODY()
+
+public:
+    AEditorActorTagDisplayBatchActor();
+
+    /** すべてのラベルを描画するコンポーネントを取得する */
+    auto GetBatchComponent() const -> UEditorActorTagDisplayBatchComponent * { return BatchComponent; }
+
+private:
+    /** すべてのラベルを描画するコンポーネント */
+    UPROPERTY()
+    TObjectPtr<UEditorActorTagDisplayBatchComponent> BatchComponent;
+};
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/PrimitiveComponent.h"
+#include "EditorActorTagDisplayBatchComponent.generated.h"
+
+// 前方宣言
+class UFont;
+class UMaterialInterface;
+class UMaterialInstanceDynamic;
+
+/** バッチ描画するラベルの1文字分のクアッド（ラベルの基準位置からの相対位置、フォントのテクセル単位） */
+struct FEditorActorTagDisplayGlyphQuad
+{
+    FVector2f OffsetMin = FVector2f::ZeroVector;
+    FVector2f OffsetMax = FVector2f::ZeroVector;
+    FVector2f UVMin = FVector2f::ZeroVector;
+    FVector2f UVMax = FVector2f::ZeroVector;
+};
+
+/**
+ * 1つの文字列のグリフ配置（同じ文字列のラベル間で共有し、作成後は変更しない）。
+ * 共有するのはCPU側の配置のみで、頂点はラベルごとに頂点バッファへ展開する。
+ */
+using FEditorActorTagDisplayGlyphRun = TArray<FEditorActorTagDisplayGlyphQuad>;
+using FEditorActorTagDisplayGlyphRunPtr = TSharedPtr<const FEditorActorTagDisplayGlyphRun, ESPMode::ThreadSafe>;
+
+/** バッチ描画するラベル1つ分の描画データ */
+struct FEditorActorTagDisplayBatchLabel
+{
+    FVector Position = FVector::ZeroVector;
+    FColor Color = FColor::White;
+
+    /** 共有しているグリフ配置のID（文字列がない場合はINDEX_NONE） */
+    int32 TextId = INDEX_NONE;
+    FEditorActorTagDisplayGlyphRunPtr Glyphs;
+};
+
+// すべてのラベルをフォントアトラスのクアッドとして1つのプリミティブで描画するコンポーネント
+// 頂点バッファはラベルの一覧か向きが変わったフレームにのみ作り直し、それ以外のフレームは再利用する
+UCLASS(Transient)
+class EDITORACTORTAGDISPLAY_API UEditorActorTagDisplayBatchComponent : public UPrimitiveComponent
+{
+    // NOLINTNEXTLINE
+    GENERATED_BODY()
+
+public:
+    UEditorActorTagDisplayBatchComponent();
+
+    /** バッチ描画できるフォントか（アトラスが1ページのオフラインキャッシュのフォントのみ） */
+    [[nodiscard]] static auto SupportsFont(const UFont *InFont) -> bool;
+
+    // ラベルの追加・削除（IDは削除されるまで変わらない）
+    auto AddLabel() -> int32;
+    auto RemoveLabel(int32 LabelId) -> void;
+
+    /** ラベルの文字列を設定する（新しくグリフ配置を作った場合はtrueを返す） */
+    auto SetLabelText(int32 LabelId, const FString &Text) -> bool;
+
+    // ラベルのプロパティ設定
+    auto SetLabelPosition(int32 LabelId, const FVector &Position) -> void;
+    auto SetLabelColor(int32 LabelId, FColor Color) -> void;
+    auto SetTextSize(float InTextSize) -> void;
+
+    /** ラベルを向けるカメラの回転を設定する（変化がなければ描画データを送り直さない） */
+    auto SetFacingRotation(const FRotator &Rotation) -> void;
+
+    /** テキストマテリアルを設定する（フォントをバインドした専用のインスタンスを作る） */
+    auto SetTextMaterial(UMaterialInterface *InMaterial) -> void;
+    auto GetTextMaterialInstance() const -> UMaterialInstanceDynamic * { return TextMaterialInstance; }
+
+    // 統計用
+    auto GetNumLabels() const -> int32 { return Labels.Num(); }
+    auto GetNumSharedGlyphLayouts() const -> int32 { return InternedGlyphRuns.Num(); }
+    auto GetLabelNumGlyphs(int32 LabelId) const -> int32;
+
+    // UPrimitiveComponent overrides
+    auto CreateSceneProxy() -> FPrimitiveSceneProxy * override;
+    auto CalcBounds(const FTransform &LocalToWorld) const -> FBoxSphereBounds override;
+    auto GetNumMaterials() const -> int32 override { return 1; }
+    auto GetMaterial(int32 ElementIndex) const -> UMaterialInterface * override;
+    auto GetUsedMaterials(TArray<UMaterialInterface *> &OutMaterials, bool bGetDebugMaterials = false) const
+        -> void override;
+
+protected:
+    auto SendRenderDynamicData_Concurrent() -> void override;
+
+private:
+    /** 共有しているグリフ配置と、その文字列・参照しているラベル数 */
+    struct FInternedGlyphRun
+    {
+        FString Text;
+        FEditorActorTagDisplayGlyphRunPtr Glyphs;
+        int32 NumLabels = 0;
+
+        /** 基準位置からグリフの角までの最大距離（フォントのテクセル単位、バウンディングの計算用） */
+        float Extent = 0.0F;
+    };
+
+    /** 大文字・小文字を区別する文字列キー */
+    struct FTextKeyFuncs : TDefaultMapKeyFuncs<FString, int32, false>
+    {
+        static auto Matches(const FString &A, const FString &B) -> bool
+        {
+            return A.Equals(B, ESearchCase::CaseSensitive);
+        }
+        static auto GetKeyHash(const FString &Key) -> uint32 { return FCrc::StrCrc32(*Key); }
+    };
+
+    // グリフ配置の共有
+    auto AssignGlyphRun(FEditorActorTagDisplayBatchLabel &Label, int32 TextId) -> void;
+    auto ReleaseGlyphRun(FEditorActorTagDisplayBatchLabel &Label) -> void;
+    auto BuildGlyphs(const FString &Text, TArray<FEditorActorTagDisplayGlyphQuad> &OutGlyphs) const -> void;
+
+    // 描画データ
+    auto GetGlyphScale() const -> float;
+    auto GatherRenderLabels() const -> TArray<FEditorActorTagDisplayBatchLabel>;
+
+    /** 描画データの変更をレンダースレッドに送り、ラベルの配置が変わった場合はバウンディングも更新する */
+    auto MarkLabelsDirty(bool bBoundsChanged) -> void;
+
+    /** TextRenderComponentと同じフォント（両方の描画方式で見た目を揃える） */
+    UPROPERTY()
+    TObjectPtr<UFont> Font;
+
+    /** すべてのラベルで共有するマテリアルインスタンス */
+    UPROPERTY()
+    TObjectPtr<UMaterialInstanceDynamic> TextMaterialInstance;
+
+    /** 1行分のワールド空間での高さ */
+    float TextSize = 30.0F;
+
+    /** ラベルを向けるカメラの回転 */
+    FRotator FacingRotation = FRotator::ZeroRotator;
+
+    /** IDで参照するラベル */
+    TSparseArray<FEditorActorTagDisplayBatchLabel> Labels;
+
+    /** IDで参照するグリフ配置 */
+    TSparseArray<FInternedGlyphRun> InternedGlyphRuns;
+
+    /** 文字列ごとのグリフ配置のID */
+    TMap<FString, int32, FDefaultSetAllocator, FTextKeyFuncs> InternedTextIds;
+
+    /** カメラの回転の変化とみなす最小の角度（度） */
+    static constexpr float FacingRotationTolerance = 0.1F;
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "EditorActorTagDisplayBenchmarkCommandlet.generated.h"
+
+// 前方宣言
+class FJsonObject;
+
+// ラベル更新処理のスケーラビリティを計測するコマンドレット
+// 一時ワールドにタグ付きアクターを生成してUpdateTextActorsを指定回数実行し、平均・p99の時間、メモリ、ラベル数をJSONで書き出す
+//
+// 使い方: UnrealEditor-Cmd <Project> -run=EditorActorTagDisplayBenchmark -nullrhi -unattended
+//        [-Actors=1000,10000,100000] [-Configs=4] [-Ticks=120] [-Output=<path>]
+UCLASS()
+class EDITORACTORTAGDISPLAY_API UEditorActorTagDisplayBenchmarkCommandlet : public UCommandlet
+{
+    // NOLINTNEXTLINE
+    GENERATED_BODY()
+
+public:
+    UEditorActorTagDisplayBenchmarkCommandlet();
+
+    // UCommandlet overrides
+    auto Main(const FString &Params) -> int32 override;
+
+    /** アクター数ごとに計測して結果を返す（設定は一時的に差し替えて復元し、保存しない。エンジンがなければnullptr） */
+    static auto RunBenchmark(TConstArrayView<int32> ActorCounts, int32 NumConfigs, int32 NumTicks)
+        -> TSharedPtr<FJsonObject>;
+
+    static constexpr int32 DefaultNumConfigs = 4;
+    static constexpr int32 DefaultNumTicks = 120;
+
+private:
+    /** 1つのアクター数で計測して結果を返す */
+    static auto RunScenario(int32 NumActors, int32 NumConfigs, int32 NumTicks) -> TSharedPtr<FJsonObject>;
+
+    static constexpr int32 NumDistinctTags = 16;
+    static constexpr double ActorSpacing = 500.0;
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorActorTagDisplayTagFilter.h"
+#include "EditorActorTagDisplayLabelSources.h"
+
+// 前方宣言
+class AActor;
+struct FActorClassTagDisplayConfig;
+
+// アクターを表示するクラス設定を求める（最初に一致したクラスの設定で、ラベルソースのいずれかが内容を返す場合のみ）
+// キャッシュは設定・クラス階層の変更時（ブループリントの再コンパイルを含む）にResetで破棄する（ゲームスレッドのみ）
+class EDITORACTORTAGDISPLAY_API FEditorActorTagDisplayConfigMatcher
+{
+public:
+    /** クラスに最初に一致する設定の番号を返す（なければINDEX_NONE） */
+    auto FindConfigIndex(const UClass *ActorClass, const TArray<FActorClassTagDisplayConfig> &ClassConfigs) -> int32;
+
+    /** 設定のタグフィルタを取得する（初回にすべてコンパイルする） */
+    auto GetTagFilter(int32 ConfigIndex, const TArray<FActorClassTagDisplayConfig> &ClassConfigs)
+        -> FEditorActorTagDisplayTagFilter &;
+
+    /** アクターを表示する設定の番号を返す（ラベルを表示しない場合はINDEX_NONE） */
+    auto MatchActor(const AActor *Actor, const TArray<FActorClassTagDisplayConfig> &ClassConfigs) -> int32;
+
+    /** MatchActorの前の簡易判定（ラベルを表示しないことが確実ならfalseを返す） */
+    auto MayShowLabel(const AActor *Actor, const TArray<FActorClassTagDisplayConfig> &ClassConfigs) -> bool;
+
+    /** 表示するタグとプロパティ値を追加し、追加したプロパティ値の行数を返す */
+    auto AppendLabelContent(const AActor *Actor, int32 ConfigIndex,
+                            const TArray<FActorClassTagDisplayConfig> &ClassConfigs, TArray<FName> &OutTags,
+                            FString &OutValueText) -> int32;
+
+    // 文字列化済みのプロパティ値の無効化
+    auto InvalidateValueText(const AActor *Actor) -> void;
+    auto InvalidateAllValueTexts() -> void;
+
+    /** クラスごとの判定結果・タグフィルタ・ラベルソースのキャッシュを破棄する */
+    auto Reset() -> void;
+
+private:
+    /** クラスごとの一致した設定の番号（一致しない場合はINDEX_NONE） */
+    TMap<TObjectKey<UClass>, int32> ClassConfigIndexCache;
+
+    /** 設定の順に並べたコンパイル済みのタグフィルタ */
+    TArray<FEditorActorTagDisplayTagFilter> TagFilters;
+
+    /** クラスごとに解決したラベルソースのプロパティ */
+    FEditorActorTagDisplayLabelSources LabelSources;
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// 前方宣言
+class AActor;
+class FEditorActorTagDisplayConfigMatcher;
+struct FActorClassTagDisplayConfig;
+
+// ラベルの作成に必要なアクターの状態をSoAで保持するスナップショット
+// ゲームスレッドで収集し、文字列・表示位置・回転をワーカースレッドで求める
+class EDITORACTORTAGDISPLAY_API FEditorActorTagDisplayLabelSnapshot
+{
+public:
+    /** 1つのワーカータスクに渡す最小のラベル数 */
+    static constexpr int32 MinParallelBatchSize = 32;
+
+    /** アクターの状態を追加する（ゲームスレッドのみ。内容のハッシュがKnownTagsHashと同じなら文字列は作らない） */
+    auto Add(AActor *Actor, int32 ConfigIndex, FEditorActorTagDisplayConfigMatcher &ConfigMatcher,
+             const TArray<FActorClassTagDisplayConfig> &ClassConfigs, const FVector &AnchorPosition,
+             const FVector &PositionOffset, uint32 KnownTagsHash, bool bHasKnownTagsHash) -> int32;
+
+    /** 確保済みのメモリを残したまま空にする */
+    auto Reset() -> void;
+    auto Num() const -> int32 { return Actors.Num(); }
+
+    /** ハッシュ・変更のあった文字列・表示位置・回転を並列に求める */
+    auto Build(const FVector &CameraLocation) -> void;
+
+    /** Buildで省略した文字列を必要になった時に作る */
+    auto EnsureText(int32 Index) -> const FString &;
+
+    // 結果の取得
+    auto GetActor(int32 Index) const -> const TWeakObjectPtr<AActor> & { return Actors[Index]; }
+    auto GetConfigIndex(int32 Index) const -> int32 { return ConfigIndices[Index]; }
+    auto GetTagsHash(int32 Index) const -> uint32 { return TagsHashes[Index]; }
+    auto GetNumTags(int32 Index) const -> int32 { return TagCounts[Index]; }
+    auto GetNumLines(int32 Index) const -> int32 { return TagCounts[Index] + ValueLineCounts[Index]; }
+    auto GetTextPosition(int32 Index) const -> const FVector & { return TextPositions[Index]; }
+    auto GetTextRotation(int32 Index) const -> const FRotator & { return TextRotations[Index]; }
+
+    // ユーティリティ関数
+    [[nodiscard]] static auto ComputeLookAtRotation(const FVector &TextPosition, const FVector &CameraLocation)
+        -> FRotator;
+    /** 大文字・小文字だけの変更も検出できるよう、表示用の文字列で求める */
+    [[nodiscard]] static auto HashTags(TConstArrayView<FName> Tags) -> uint32;
+    static auto AppendTagsText(TConstArrayView<FName> Tags, FString &OutText) -> void;
+
+private:
+    auto GetTags(int32 Index) const -> TConstArrayView<FName>;
+    auto GetValueText(int32 Index) const -> FStringView;
+    auto HashContent(int32 Index) const -> uint32;
+
+    /** タグ、プロパティ値の順に1行ずつ並べた文字列を作る */
+    auto BuildText(int32 Index, FString &OutText) const -> void;
+
+    // ゲームスレッドでの入力
+    TArray<TWeakObjectPtr<AActor>> Actors;
+    TArray<int32> ConfigIndices;
+    TArray<FVector> AnchorPositions;
+    TArray<FVector> PositionOffsets;
+    TArray<uint32> KnownTagsHashes;
+    TArray<bool> HasKnownTagsHash;
+
+    /** 全ラベルのタグを詰めて格納する（TagStarts・TagCountsで参照） */
+    TArray<FName> TagNames;
+    TArray<int32> TagStarts;
+    TArray<int32> TagCounts;
+
+    /** 全ラベルの文字列化済みのプロパティ値を詰めて格納する */
+    FString ValueTexts;
+    TArray<int32> ValueTextStarts;
+    TArray<int32> ValueTextLengths;
+    TArray<int32> ValueLineCounts;
+
+    // ワーカースレッドでの出力
+    TArray<uint32> TagsHashes;
+    TArray<FString> Texts;
+    TArray<bool> HasText;
+    TArray<FVector> TextPositions;
+    TArray<FRotator> TextRotations;
+};
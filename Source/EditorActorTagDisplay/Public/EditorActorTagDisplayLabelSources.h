@@ -0,0 +1,102 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+// 前方宣言
+class AActor;
+class FEditorActorTagDisplayTagFilter;
+class FObjectProperty;
+class FProperty;
+struct FActorClassTagDisplayConfig;
+struct FEditorActorTagDisplayLabelSource;
+
+// 設定のラベル取得元（タグ・プロパティ値）からラベルの内容を読み出す
+// プロパティパスはクラスごとに一度だけ解決してキャッシュする（クラスの再コンパイル時はResetが必要）
+class EDITORACTORTAGDISPLAY_API FEditorActorTagDisplayLabelSources
+{
+public:
+    /** アクターのタグ以外の取得元を持つかどうか */
+    [[nodiscard]] static auto HasExtraSources(const FActorClassTagDisplayConfig &Config) -> bool;
+
+    /** いずれかの取得元が表示する内容を持つかどうか（空文字列になる値は内容なしとみなす） */
+    auto HasContent(const AActor *Actor, const FActorClassTagDisplayConfig &Config,
+                    FEditorActorTagDisplayTagFilter &TagFilter) -> bool;
+
+    /** タグをOutTagsに、値の行をOutValueTextに追加し、追加した値の行数を返す */
+    auto AppendContent(const AActor *Actor, const FActorClassTagDisplayConfig &Config,
+                       FEditorActorTagDisplayTagFilter &TagFilter, TArray<FName> &OutTags, FString &OutValueText)
+        -> int32;
+
+    // 値の文字列キャッシュの破棄
+    auto InvalidateValueText(const AActor *Actor) -> void;
+    auto InvalidateAllValueTexts() -> void;
+
+    /** 解決済みのプロパティと値の文字列キャッシュを破棄する */
+    auto Reset() -> void;
+
+private:
+    /** 取得元の読み出し方法 */
+    enum class EContentKind : uint8
+    {
+        ActorTags,
+        ComponentTags,
+        GameplayTagContainer,
+        GameplayTag,
+        NameArray,
+        ValueText,
+        Unresolved,
+    };
+
+    /** プロパティチェーンの1要素（Objectはたどるオブジェクト参照の場合のみ設定） */
+    struct FChainLink
+    {
+        const FProperty *Property = nullptr;
+        const FObjectProperty *Object = nullptr;
+    };
+
+    /** クラスに対して解決済みの取得元 */
+    struct FResolvedSource
+    {
+        EContentKind Kind = EContentKind::Unresolved;
+
+        /** アクターから値までのプロパティ */
+        TArray<FChainLink, TInlineAllocator<4>> Chain;
+
+        /** 値の行の接頭辞（"Path: "） */
+        FString Caption;
+    };
+
+    /** 文字列化済みの値の行 */
+    struct FValueText
+    {
+        FString Text;
+        int32 NumLines = 0;
+    };
+
+    // 取得元の解決
+    auto Resolve(const UClass *ActorClass, const FActorClassTagDisplayConfig &Config)
+        -> TConstArrayView<FResolvedSource>;
+    static auto ResolveSource(const UClass *ActorClass, const FEditorActorTagDisplayLabelSource &Source)
+        -> FResolvedSource;
+
+    // 内容の読み出し
+    static auto ReadValue(const AActor *Actor, const FResolvedSource &Source) -> const void *;
+    static auto AppendSourceTags(const AActor *Actor, const FResolvedSource &Source,
+                                 FEditorActorTagDisplayTagFilter &TagFilter, TArray<FName> &OutTags) -> int32;
+    auto GetValueText(const AActor *Actor, TConstArrayView<FResolvedSource> Sources) -> const FValueText &;
+    static auto FormatValueText(const AActor *Actor, TConstArrayView<FResolvedSource> Sources, FValueText &OutValue)
+        -> void;
+
+    /** クラスごとの解決済みの取得元 */
+    TMap<TObjectKey<UClass>, TArray<FResolvedSource>> SourcesByClass;
+
+    /** アクターごとの値の文字列（プロパティの変更・アンドゥで破棄する） */
+    TMap<TObjectKey<AActor>, FValueText> ValueTextByActor;
+
+    /** キャッシュしない値の文字列化に使う作業領域 */
+    FValueText ScratchValueText;
+
+    /** HasContentの作業領域 */
+    TArray<FName> ScratchTags;
+};
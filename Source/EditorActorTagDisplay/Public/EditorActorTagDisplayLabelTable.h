@@ -0,0 +1,127 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// 前方宣言
+class AActor;
+class AEditorActorTagDisplayActor;
+
+/** ラベル1つ分の描画リソースと、最後に書き込んだ値のフィンガープリント */
+struct FEditorActorTagDisplayLabelEntry
+{
+    TWeakObjectPtr<AEditorActorTagDisplayActor> TextActor;
+
+    /** バッチ描画・キャンバス描画でのラベルID */
+    int32 BatchLabelId = INDEX_NONE;
+
+    /** 最後に書き込んだ文字列のグリフ数（統計用） */
+    int32 NumGlyphs = 0;
+
+    /** 最後に書き込んだ文字色 */
+    FColor Color = FColor::White;
+
+    /** 最後に書き込んだ量子化済みの位置・回転 */
+    FIntVector QuantizedLocation = FIntVector::ZeroValue;
+    FIntVector QuantizedRotation = FIntVector::ZeroValue;
+
+    /** フィンガープリントが一度でも書き込まれたか */
+    bool bIsFingerprintValid = false;
+};
+
+// ワールドごとのラベルを、削除まで変わらないスロット番号で参照する並列配列に格納するテーブル
+// パスごとに世代を進め、MarkSeenされなかったラベルをSweepUnseenの1回の線形走査で取り除く
+class EDITORACTORTAGDISPLAY_API FEditorActorTagDisplayLabelTable
+{
+public:
+    auto Num() const -> int32 { return NumLabels; }
+
+    auto IsValidHandle(int32 Handle) const -> bool
+    {
+        return LastSeenGenerations.IsValidIndex(Handle) && LastSeenGenerations[Handle] != FreeGeneration;
+    }
+
+    // 検索・追加・削除
+    auto Find(const TWeakObjectPtr<AActor> &Actor) const -> int32;
+
+    auto Contains(const TWeakObjectPtr<AActor> &Actor) const -> bool { return SlotByActor.Contains(Actor); }
+
+    /** ラベルがなければ、現在のパスで見つかったものとして空のラベルを追加する */
+    auto FindOrAdd(const TWeakObjectPtr<AActor> &Actor) -> int32;
+
+    auto Remove(int32 Handle) -> void;
+
+    auto Reset() -> void;
+
+    // パスの世代管理
+    auto BeginPass() -> void;
+
+    auto GetGeneration() const -> uint32 { return Generation; }
+
+    auto MarkSeen(int32 Handle) -> void { LastSeenGenerations[Handle] = Generation; }
+
+    /** アクターのラベルを現在のパスで見つかったものとし、ラベルがあるかを返す */
+    auto MarkSeen(const TWeakObjectPtr<AActor> &Actor) -> bool;
+
+    /** 現在のパスで見つからなかったラベルごとにFuncを呼んでから削除する */
+    template <typename FuncType> auto SweepUnseen(FuncType &&Func) -> void
+    {
+        for (int32 Handle = 0; Handle < LastSeenGenerations.Num(); ++Handle)
+        {
+            const uint32 LastSeenGeneration = LastSeenGenerations[Handle];
+            if (LastSeenGeneration != FreeGeneration && LastSeenGeneration != Generation)
+            {
+                Func(Handle);
+                Remove(Handle);
+            }
+        }
+    }
+
+    /** すべてのラベルについてスロット順にFuncを呼ぶ */
+    template <typename FuncType> auto ForEachLabel(FuncType &&Func) const -> void
+    {
+        for (int32 Handle = 0; Handle < LastSeenGenerations.Num(); ++Handle)
+        {
+            if (LastSeenGenerations[Handle] != FreeGeneration)
+            {
+                Func(Handle);
+            }
+        }
+    }
+
+    // ラベルごとの状態
+    auto GetEntry(int32 Handle) -> FEditorActorTagDisplayLabelEntry & { return Entries[Handle]; }
+    auto GetEntry(int32 Handle) const -> const FEditorActorTagDisplayLabelEntry & { return Entries[Handle]; }
+
+    /** 最後に書き込んだタグのハッシュ */
+    auto GetTextHash(int32 Handle) const -> uint32 { return TextHashes[Handle]; }
+    auto SetTextHash(int32 Handle, uint32 TextHash) -> void { TextHashes[Handle] = TextHash; }
+
+    /** 最後に求めた表示位置（基準位置とクラスごとのオフセット） */
+    auto GetAnchor(int32 Handle) const -> const FVector & { return Anchors[Handle]; }
+    auto SetAnchor(int32 Handle, const FVector &Anchor) -> void { Anchors[Handle] = Anchor; }
+
+private:
+    /** 空きスロットの世代（パスでは使わない） */
+    static constexpr uint32 FreeGeneration = 0;
+
+    /** アクターを解決せずに、弱参照のインデックスとシリアル番号で比較する */
+    struct FActorKeyFuncs : TDefaultMapKeyFuncs<TWeakObjectPtr<AActor>, int32, false>
+    {
+        static auto Matches(KeyInitType A, KeyInitType B) -> bool { return A.HasSameIndexAndSerialNumber(B); }
+    };
+
+    // スロット番号で参照する並列配列
+    TArray<TWeakObjectPtr<AActor>> Actors;
+    TArray<uint32> LastSeenGenerations;
+    TArray<uint32> TextHashes;
+    TArray<FVector> Anchors;
+    TArray<FEditorActorTagDisplayLabelEntry> Entries;
+
+    /** 空きスロット（後入れ先出しで再利用する） */
+    TArray<int32> FreeSlots;
+
+    TMap<TWeakObjectPtr<AActor>, int32, FDefaultSetAllocator, FActorKeyFuncs> SlotByActor;
+
+    uint32 Generation = 1;
+    int32 NumLabels = 0;
+};
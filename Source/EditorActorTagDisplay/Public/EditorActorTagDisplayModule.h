@@ -2,19 +2,213 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+#include "UObject/GCObject.h"
+#include "Camera/CameraTypes.h"
+#include "EditorActorTagDisplaySpatialIndex.h"
+#include "EditorActorTagDisplayLabelSnapshot.h"
+#include "EditorActorTagDisplayAnchorCache.h"
+#include "EditorActorTagDisplayLabelTable.h"
+#include "EditorActorTagDisplayConfigMatcher.h"
+#include "EditorActorTagDisplaySettings.h"
 
 // 前方宣言
 class AActor;
 class UTextRenderComponent;
 class UWorld;
+class ULevel;
 class UEditorActorTagDisplaySettings;
 class AEditorActorTagDisplayActor;
+class AEditorActorTagDisplayBatchActor;
+class UEditorActorTagDisplayBatchComponent;
 class UMaterialInterface;
+class UMaterialInstanceDynamic;
+class UCanvas;
+class APlayerController;
+class FEditorViewportClient;
+class IConsoleObject;
+class FTransactionObjectEvent;
 struct FActorClassTagDisplayConfig;
+struct FConvexVolume;
+struct FStreamableHandle;
+struct FPropertyChangedEvent;
 
-class FEditorActorTagDisplayModule : public IModuleInterface
+class FEditorActorTagDisplayModule : public IModuleInterface, public FGCObject
 {
 public:
+    /** テキストアクターと、前回書き込んだ値のフィンガープリント（ラベルテーブルのスロットごとに1つ） */
+    using FTextActorEntry = FEditorActorTagDisplayLabelEntry;
+
+    /** プールに戻されたラベルアクター */
+    struct FPooledTextActor
+    {
+        TWeakObjectPtr<AEditorActorTagDisplayActor> TextActor;
+
+        /** プールに戻された時刻（FPlatformTime::Seconds） */
+        double ReleaseTime = 0.0;
+    };
+
+    /** キャンバス描画モードのラベル */
+    struct FOverlayLabel
+    {
+        FText Text;
+        FVector Position = FVector::ZeroVector;
+        FColor Color = FColor::White;
+
+        /** 基準位置の上に積み上げる行数 */
+        int32 NumLines = 1;
+
+        /** 表示数の上限に達したときの優先度（クラス設定のLabel Priority） */
+        double Priority = 1.0;
+    };
+
+    /** キャンバス描画モードのビューごとの描画結果（上限付近でのちらつき防止用） */
+    struct FOverlayViewState
+    {
+        /** 最後に描画したフレームで描画したラベル（ラベルIDで参照） */
+        TBitArray<> DrawnLabels;
+
+        /** 最後に描画したフレーム */
+        uint64 LastDrawnFrame = 0;
+    };
+
+    /** ビューごとに投影したキャンバス描画モードのラベル */
+    struct FProjectedOverlayLabel
+    {
+        int32 LabelId = INDEX_NONE;
+        FVector2D ScreenPosition = FVector2D::ZeroVector;
+
+        /** ワールド空間の文字サイズに合わせるためのフォントの拡大率 */
+        double TextScale = 1.0;
+
+        /** 表示数の上限に達したときの順位付けの値（小さいほど優先） */
+        double Score = 0.0;
+    };
+
+    /** 表示数の上限で順位付けする候補（Indexは候補の配列内の位置） */
+    struct FRankedLabel
+    {
+        int32 Index = INDEX_NONE;
+        double Score = 0.0;
+    };
+
+    /** 追跡中のレベルと、そのレベルで表示条件に一致しているアクター */
+    struct FTrackedLevel
+    {
+        TWeakObjectPtr<ULevel> Level;
+        TSet<TWeakObjectPtr<AActor>> Actors;
+
+        /** World Partitionによるアクターの読み込み・破棄の通知のハンドル */
+        FDelegateHandle LoadedActorAddedHandle;
+        FDelegateHandle LoadedActorRemovedHandle;
+    };
+
+    /** ラベルごとに予約された処理 */
+    struct FPendingLabelWork
+    {
+        /** 新たに可視になり、ラベルの生成が必要 */
+        bool bCreate = false;
+
+        /** タグ・色・位置の再評価が必要 */
+        bool bRefresh = false;
+
+        /** 生成を予約した可視判定の世代（ラベルテーブルの世代と一致する間のみ可視とみなす） */
+        uint32 VisibleGeneration = 0;
+    };
+
+    /** 優先度付けされた予約処理（Priorityが小さいほど先に処理する） */
+    struct FScheduledLabelWork
+    {
+        TWeakObjectPtr<AActor> Actor;
+        double Priority = 0.0;
+    };
+
+    /**
+     * ワールドごとのラベルの状態（エディターワールドとPIEのワールドごとに1つ）。
+     * ラベル・インデックス・予約済みの処理・カメラはワールドごとに独立しており、
+     * 描画されていないワールドのコンテキストは更新を止める。
+     */
+    struct FLabelContext
+    {
+        /** ラベルを表示するワールド */
+        TWeakObjectPtr<UWorld> World;
+
+        /** アクターごとのラベル（スロットの世代で、走査で見つからなかったラベルを判定する） */
+        FEditorActorTagDisplayLabelTable Labels;
+
+        /** 今フレームのカメラ（ラベルごとに取得し直さないためのキャッシュ） */
+        FMinimalViewInfo FrameCameraView;
+        FVector FrameCameraLocation = FVector::ZeroVector;
+        bool bHasFrameCameraView = false;
+
+        /** 追跡中のアクターのラベル位置の空間インデックス */
+        FEditorActorTagDisplaySpatialIndex SpatialIndex;
+
+        /** 可視判定（カリングまたは表示数の上限）でラベルを絞り込んでいるか（無効時は追跡中の全アクターにラベルを生成する） */
+        bool bIsVisibleSetActive = false;
+
+        /** カメラがないために表示数の上限を適用しないことをログに出力したかどうか */
+        bool bHasLoggedUnlimitedLabels = false;
+
+        /** 予算超過で次フレーム以降に持ち越されたものを含む、予約済みのラベル処理 */
+        TMap<TWeakObjectPtr<AActor>, FPendingLabelWork> PendingLabelWork;
+
+        /** 遠くのラベルの向きを順番に更新するためのフレームカウンタ */
+        uint32 RotationRefreshFrame = 0;
+
+        /** 追跡中のアクターのラベル基準位置のキャッシュ（インクリメンタル更新時のみ使用） */
+        FEditorActorTagDisplayAnchorCache AnchorCache;
+
+        /** 再利用待ちのラベルアクター（プールに戻された順） */
+        TArray<FPooledTextActor> TextActorPool;
+
+        /** バッチ描画モードで全ラベルを描画するアクター */
+        TWeakObjectPtr<AEditorActorTagDisplayBatchActor> BatchActor;
+
+        /** キャンバス描画モードのラベル（IDで参照） */
+        TSparseArray<FOverlayLabel> OverlayLabels;
+
+        /** キャンバス描画モードのビューごとの描画結果（ビューのキーで参照） */
+        TMap<uint32, FOverlayViewState> OverlayViewStates;
+
+        /** 現在のラベルが生成された描画方式 */
+        EEditorActorTagDisplayRenderMode ActiveRenderMode = EEditorActorTagDisplayRenderMode::PerActor;
+
+        /** インクリメンタル更新でアクターを追跡中かどうか */
+        bool bIsTrackingActors = false;
+
+        /** 追跡中のワールドのレベル構成変更デリゲートのハンドル */
+        FDelegateHandle LevelsChangedDelegateHandle;
+
+        /** 表示条件に一致しているアクターと、その所属レベル */
+        TMap<TWeakObjectPtr<AActor>, TObjectKey<ULevel>> TrackedActors;
+
+        /** 表示中のレベル（レベル単位でまとめて登録・破棄する） */
+        TMap<TObjectKey<ULevel>, FTrackedLevel> TrackedLevels;
+
+        /** 次のティックで再評価が必要なアクターの集合 */
+        TSet<TWeakObjectPtr<AActor>> DirtyActors;
+
+        /** 次のティックでワールド全体の走査が必要かどうか */
+        bool bNeedsFullSweep = true;
+
+        /** 設定やPIEの状態が変わり、次のティックで更新が必要かどうか */
+        bool bIsDirty = true;
+
+        /** 最後に更新を行ったフレームのカメラ（移動量の判定用） */
+        FMinimalViewInfo LastUpdateCameraView;
+        bool bHasLastUpdateCameraView = false;
+
+        /** 変化がなくなった後、遠いラベルの向きが一巡するまで更新を続ける残りフレーム数 */
+        int32 NumSettleFrames = 0;
+    };
+
+    /** 書き込みの発行数とスキップ数 */
+    struct FWriteCounter
+    {
+        uint64 Issued = 0;
+        uint64 Skipped = 0;
+    };
+
     // マテリアルパス定数
     static constexpr const TCHAR *TEXT_MATERIAL_PATH =
         TEXT("/EditorActorTagDisplay/Materials/M_TextMaterial.M_TextMaterial");
@@ -23,58 +217,326 @@ public:
     auto StartupModule() -> void override;
     auto ShutdownModule() -> void override;
 
+    // FGCObject implementation
+    auto AddReferencedObjects(FReferenceCollector &Collector) -> void override;
+    auto GetReferencerName() const -> FString override { return TEXT("FEditorActorTagDisplayModule"); }
+
+    /** ラベルを1フレーム分更新する（通常はティッカーから呼ばれる） */
+    auto UpdateTextActors() -> void;
+
+    /** ラベルを表示するワールドを差し替える（ベンチマーク用。nullptrでエディター・PIEのワールドに戻す） */
+    auto SetWorldOverride(UWorld *World) -> void;
+
+    /** 全ワールドの現在のラベル数を取得する */
+    auto GetNumLabels() const -> int32;
+
+    /** テキストマテリアルの非同期読み込みの完了を待つ（ティックしないベンチマーク用） */
+    auto WaitForTextMaterials() -> void;
+
 private:
+    /** 変更検出に用いる位置（cm）・回転（度）の量子化単位 */
+    static constexpr double LocationQuantizeStep = 0.1;
+    static constexpr double RotationQuantizeStep = 0.1;
+
+    /** 新たに可視になったラベルの優先度に掛ける係数（距離をこの割合とみなす） */
+    static constexpr double NewlyVisiblePriorityScale = 0.25;
+
+    /** 表示中のラベルの順位付けで距離に掛ける係数（上限付近でラベルが入れ替わり続けるのを防ぐ） */
+    static constexpr double VisibleLabelHysteresisScale = 0.8;
+
+    /** 順位付けで距離を割る優先度の下限 */
+    static constexpr double MinLabelPriority = 0.01;
+
+    /** 1回の並列処理にまとめるラベル数（予算の判定はこの単位で行う） */
+    static constexpr int32 LabelSnapshotBatchSize = 128;
+
+    /** キャンバス描画でラベルの一部が画面内に残る範囲（正規化デバイス座標） */
+    static constexpr double OverlayScreenMargin = 1.1;
+
+    /** これ未満のカメラの移動（cm）・回転（度）・画角（度）の変化ではラベルを更新しない */
+    static constexpr double IdleCameraLocationThreshold = 1.0;
+    static constexpr double IdleCameraRotationThreshold = 0.1;
+    static constexpr float IdleCameraFOVThreshold = 0.1F;
+
+    /** プールのラベルアクターの期限切れを確認する間隔（秒） */
+    static constexpr float PoolTrimTickInterval = 1.0F;
+
+    /** ラベルを表示するワールドの一覧（エディターワールドと少数のPIEワールド） */
+    using FLabelWorldArray = TArray<UWorld *, TInlineAllocator<4>>;
+
     // モジュール初期化・終了関連
+    auto ActivateModule() -> void;
     auto RegisterDebugDrawDelegate() -> void;
     auto UnregisterDebugDrawDelegate() -> void;
+
+    // 更新ティッカー（表示が無効な間は登録しない）
+    auto RegisterUpdateTicker() -> void;
+    auto UnregisterUpdateTicker() -> void;
+    auto RegisterPoolTrimTicker() -> void;
+    auto UnregisterPoolTrimTicker() -> void;
+    auto OnTagDisplayEnabledChanged(bool bEnabled) -> void;
     static auto AddViewportShowFlagExtension() -> void;
     auto RemoveViewportShowFlagExtension() -> void;
 
+    // ワールドごとのラベルコンテキスト
+    auto GetLabelWorlds(FLabelWorldArray &OutWorlds) const -> void;
+    auto RefreshLabelWorlds() -> void;
+    [[nodiscard]] auto IsWorldRendered(UWorld *World) const -> bool;
+    [[nodiscard]] auto FindLabelContext(const UWorld *World) -> FLabelContext *;
+    auto GetOrAddLabelContext(UWorld *World) -> FLabelContext &;
+    auto RemoveLabelContext(const TObjectKey<UWorld> &WorldKey, bool bIsWorldTornDown) -> void;
+    auto RemoveAllLabelContexts() -> void;
+    auto UpdateLabelContext(FLabelContext &Context, UWorld *World, const UEditorActorTagDisplaySettings *Settings)
+        -> void;
+    auto OnWorldCleanup(UWorld *World, bool bSessionEnded, bool bCleanupResources) -> void;
+
+    // 変化のないフレームの省略
+    [[nodiscard]] static auto ConsumeLabelContextChanges(FLabelContext &Context,
+                                                         const UEditorActorTagDisplaySettings *Settings) -> bool;
+    [[nodiscard]] static auto HasCameraMoved(const FLabelContext &Context) -> bool;
+    [[nodiscard]] static auto IsLabelContextIdle(FLabelContext &Context, UWorld *World,
+                                                 const UEditorActorTagDisplaySettings *Settings) -> bool;
+    auto MarkAllLabelContextsDirty() -> void;
+
     // テキストアクター管理
-    auto UpdateTextActors() -> void;
-    auto CleanupTextActors() -> void;
-    auto RemoveUnusedTextActors(const TSet<TWeakObjectPtr<AActor>> &ProcessedActors) -> void;
+    auto CleanupTextActors(FLabelContext &Context) -> void;
+    auto RemoveUnusedTextActors(FLabelContext &Context) -> void;
 
     // ワールド・アクター処理
-    [[nodiscard]] static auto GetEditorWorld() -> UWorld *;
-    auto ProcessActorsInWorld(UWorld *World, const UEditorActorTagDisplaySettings *Settings,
-                              TSet<TWeakObjectPtr<AActor>> &ProcessedActors) -> void;
-    auto ProcessActorIfMatched(AActor *Actor, const UEditorActorTagDisplaySettings *Settings,
-                               TSet<TWeakObjectPtr<AActor>> &ProcessedActors) -> void;
+    auto ProcessActorsInWorld(FLabelContext &Context, UWorld *World, const UEditorActorTagDisplaySettings *Settings)
+        -> void;
+    [[nodiscard]] auto FindMatchingConfig(const AActor *Actor, const UEditorActorTagDisplaySettings *Settings)
+        -> const FActorClassTagDisplayConfig *;
+    [[nodiscard]] auto FindMatchingConfigIndex(const UClass *ActorClass, const UEditorActorTagDisplaySettings *Settings)
+        -> int32;
+    [[nodiscard]] auto MayShowLabel(const AActor *Actor) -> bool;
+
+    // クラス一致キャッシュ
+    auto RegisterClassCacheDelegates() -> void;
+    auto UnregisterClassCacheDelegates() -> void;
+    auto InvalidateClassConfigCache() -> void;
+
+    // インクリメンタル更新
+    auto RegisterActorTrackingDelegates() -> void;
+    auto UnregisterActorTrackingDelegates() -> void;
+    auto UpdateTextActorsIncremental(FLabelContext &Context, UWorld *World,
+                                     const UEditorActorTagDisplaySettings *Settings) -> void;
+    auto SweepTrackedWorld(FLabelContext &Context, UWorld *World) -> void;
+    auto MarkTrackedActorsDirty(FLabelContext &Context) -> void;
+    auto ProcessDirtyActors(FLabelContext &Context, UWorld *World, const UEditorActorTagDisplaySettings *Settings)
+        -> void;
+    auto RefreshTextActorRotations(FLabelContext &Context, const UEditorActorTagDisplaySettings *Settings) -> void;
+    auto RemoveTextActor(FLabelContext &Context, const TWeakObjectPtr<AActor> &Actor) -> void;
+    auto UntrackActor(FLabelContext &Context, const TWeakObjectPtr<AActor> &Actor) -> void;
+    auto ResetActorTracking(FLabelContext &Context) -> void;
+    auto MarkActorDirty(AActor *Actor) -> void;
+
+    // レベル単位の登録（レベルストリーミング・World Partition）
+    auto ReconcileTrackedLevels(FLabelContext &Context, UWorld *World) -> void;
+    auto RegisterTrackedLevel(FLabelContext &Context, ULevel *Level) -> void;
+    auto UnregisterTrackedLevel(FLabelContext &Context, const TObjectKey<ULevel> &LevelKey) -> void;
+    auto OnLevelAddedToWorld(ULevel *Level, UWorld *World) -> void;
+    auto OnLevelRemovedFromWorld(ULevel *Level, UWorld *World) -> void;
+    auto OnLoadedActorAdded(AActor &Actor) -> void;
+    auto OnLoadedActorRemoved(AActor &Actor) -> void;
+
+    // 予算付きのラベル処理スケジューラ
+    auto DrainLabelWork(FLabelContext &Context, const UEditorActorTagDisplaySettings *Settings) -> void;
+    auto ExecuteLabelWork(FLabelContext &Context, const TWeakObjectPtr<AActor> &WeakActor,
+                          const FPendingLabelWork &Work, const UEditorActorTagDisplaySettings *Settings) -> void;
+
+    // スナップショットとワーカーによるラベル計算
+    auto SnapshotLabel(FLabelContext &Context, AActor *Actor, int32 ConfigIndex,
+                       const UEditorActorTagDisplaySettings *Settings) -> void;
+    auto FlushLabelSnapshot(FLabelContext &Context, const UEditorActorTagDisplaySettings *Settings) -> void;
+
+    // アクターイベントハンドラ
+    auto OnLevelActorAdded(AActor *Actor) -> void;
+    auto OnLevelActorDeleted(AActor *Actor) -> void;
+    auto OnActorMoved(AActor *Actor) -> void;
+    auto OnObjectPropertyChanged(UObject *Object, FPropertyChangedEvent &PropertyChangedEvent) -> void;
+    auto OnObjectTransacted(UObject *Object, const FTransactionObjectEvent &TransactionEvent) -> void;
+    auto OnComponentPhysicsStateChanged(UActorComponent *Component) -> void;
 
     // テキストアクター作成・更新
-    auto CreateOrUpdateTextActor(AActor *Actor, const FActorClassTagDisplayConfig &Config) -> void;
-    auto GetOrCreateTextActor(AActor *Actor) -> AEditorActorTagDisplayActor *;
-    static auto SetupTextActor(AEditorActorTagDisplayActor *TextActor) -> void;
-    static auto UpdateTextActorProperties(AEditorActorTagDisplayActor *TextActor, const FString &CombinedTags,
-                                          const FActorClassTagDisplayConfig &Config, AActor *Actor) -> void;
-    static auto UpdateTextActorRotation(AEditorActorTagDisplayActor *TextActor, const FVector &TextPosition) -> void;
+    auto CreateOrUpdateTextActor(FLabelContext &Context, AActor *Actor, const FActorClassTagDisplayConfig &Config,
+                                 int32 SnapshotIndex) -> void;
+    auto GetOrCreateTextActor(FLabelContext &Context, AActor *Actor) -> int32;
+    auto SetupTextActor(AEditorActorTagDisplayActor *TextActor) -> void;
+    auto UpdateTextActorProperties(FLabelContext &Context, int32 LabelHandle, const FActorClassTagDisplayConfig &Config,
+                                   int32 SnapshotIndex) -> void;
+    auto UpdateTextActorRotation(FLabelContext &Context, FTextActorEntry &Entry, const FRotator &LookAtRotation)
+        -> void;
+    auto ReleaseTextActorEntry(FLabelContext &Context, FTextActorEntry &Entry) -> void;
+
+    // ラベルアクターのプール
+    auto AcquirePooledTextActor(FLabelContext &Context, UWorld *World) -> AEditorActorTagDisplayActor *;
+    auto ReleaseTextActorToPool(FLabelContext &Context, AEditorActorTagDisplayActor *TextActor) -> void;
+    auto TrimTextActorPool(FLabelContext &Context) -> void;
+    auto EmptyTextActorPool(FLabelContext &Context) -> void;
+    [[nodiscard]] auto ComputeTextPosition(FLabelContext &Context, AActor *Actor,
+                                           const FActorClassTagDisplayConfig &Config) -> FVector;
+
+    // バッチ描画
+    [[nodiscard]] static auto GetEffectiveRenderMode(const UEditorActorTagDisplaySettings *Settings)
+        -> EEditorActorTagDisplayRenderMode;
+    auto GetOrCreateBatchComponent(FLabelContext &Context, UWorld *World) -> UEditorActorTagDisplayBatchComponent *;
+    auto UpdateBatchedLabelProperties(FLabelContext &Context, int32 LabelHandle,
+                                      UEditorActorTagDisplayBatchComponent &BatchComponent,
+                                      const FActorClassTagDisplayConfig &Config, int32 SnapshotIndex) -> void;
+
+    // キャンバス描画
+    auto UpdateOverlayLabelProperties(FLabelContext &Context, int32 LabelHandle,
+                                      const FActorClassTagDisplayConfig &Config, AActor *Actor, int32 SnapshotIndex)
+        -> void;
+    auto DrawCanvasOverlay(UCanvas *Canvas, APlayerController *PlayerController, bool bIsGameView) -> void;
 
     // マテリアル設定
-    static auto SetTextMaterial(UTextRenderComponent *TextComponent) -> void;
-    static auto ApplyMaterial(UTextRenderComponent *TextComponent, UMaterialInterface *TextMaterial) -> void;
+    auto RequestTextMaterials() -> void;
+    auto OnTextMaterialsLoaded() -> void;
+    auto SetTextMaterial(UTextRenderComponent *TextComponent) -> void;
+    auto GetTextBaseMaterial() -> UMaterialInterface *;
+    auto GetOrCreateSharedTextMaterial() -> UMaterialInterface *;
+    auto ResetTextMaterials() -> void;
 
     // フォントサイズ変更処理
     auto UpdateAllTextActorSizes() -> void;
     auto UpdateAllTextActorOutlineWidth() -> void;
 
     // ユーティリティ関数
-    static auto CombineActorTags(AActor *Actor) -> FString;
-    static auto GetCameraLocation() -> FVector;
+    [[nodiscard]] static auto QuantizeVector(const FVector &Value, double Step) -> FIntVector;
+    static auto GetCameraView(UWorld *World, FMinimalViewInfo &OutViewInfo) -> bool;
+    static auto GetViewInfoFromViewportClient(const FEditorViewportClient &ViewportClient,
+                                              FMinimalViewInfo &OutViewInfo) -> void;
+    static auto ComputeViewFrustum(const FMinimalViewInfo &ViewInfo, FConvexVolume &OutFrustum) -> bool;
+
+    // 視錐台・距離カリング
+    auto MaterializeVisibleLabels(FLabelContext &Context, const UEditorActorTagDisplaySettings *Settings,
+                                  const FConvexVolume *ViewFrustum) -> void;
+
+    // 表示数の上限（距離と優先度による上位K件の選択）
+    [[nodiscard]] static auto ShouldLimitVisibleLabels(FLabelContext &Context,
+                                                       const UEditorActorTagDisplaySettings *Settings) -> bool;
+    auto LimitVisibleActors(FLabelContext &Context, const UEditorActorTagDisplaySettings *Settings) -> void;
+    auto LimitProjectedOverlayLabels(int32 MaxVisibleLabels) -> void;
+    static auto PushRankedLabel(TArray<FRankedLabel> &RankedLabels, const FRankedLabel &Label, int32 MaxLabels)
+        -> void;
+    [[nodiscard]] static auto GetLabelPriority(const FActorClassTagDisplayConfig &Config) -> double;
+
+    // 書き込み統計
+    auto DumpWriteStats(const TArray<FString> &Args) -> void;
+
+    // stat EditorActorTagDisplay・CSVプロファイラ用の集計
+    auto UpdateFrameStats() const -> void;
 
     // メンバ変数
-    /** デバッグ描画デリゲートのハンドル */
+    /** デバッグ描画デリゲートのハンドル（エディタービュー・ゲームビュー） */
     FDelegateHandle DrawDelegateHandle;
+    FDelegateHandle GameDrawDelegateHandle;
 
     /** テキストコンポーネント更新用のティッカーハンドル */
     FTSTicker::FDelegateHandle TickDelegateHandle;
 
+    /** 表示が無効な間にプールを縮小するティッカーハンドル */
+    FTSTicker::FDelegateHandle PoolTrimTickDelegateHandle;
+
+    /** 表示の有効・無効の切り替えと、その他の設定変更のデリゲートのハンドル */
+    FDelegateHandle TagDisplayEnabledChangedDelegateHandle;
+    FDelegateHandle SettingChangedDelegateHandle;
+
+    /** PIEの開始・終了デリゲートのハンドル */
+    FDelegateHandle PostPIEStartedDelegateHandle;
+    FDelegateHandle EndPIEDelegateHandle;
+
     /** フォントサイズ変更デリゲートのハンドル */
     FDelegateHandle TextSizeChangedDelegateHandle;
 
     /** OutlineWidth変更デリゲートのハンドル */
     FDelegateHandle OutlineWidthChangedDelegateHandle;
 
-    /** アクターごとのEditorActorTagDisplayActorを管理するマップ */
-    TMap<TWeakObjectPtr<AActor>, TWeakObjectPtr<AEditorActorTagDisplayActor>> TextActorMap;
+    /** テキストマテリアル変更デリゲートのハンドル */
+    FDelegateHandle TextMaterialChangedDelegateHandle;
+
+    /** ClassConfigs変更デリゲートのハンドル */
+    FDelegateHandle ClassConfigsChangedDelegateHandle;
+
+    /** クラス一致キャッシュ無効化用デリゲートのハンドル */
+    FDelegateHandle ReloadCompleteDelegateHandle;
+    FDelegateHandle BlueprintCompiledDelegateHandle;
+
+    /** アクター追跡用デリゲートのハンドル */
+    FDelegateHandle LevelActorAddedDelegateHandle;
+    FDelegateHandle LevelActorDeletedDelegateHandle;
+    FDelegateHandle ActorMovedDelegateHandle;
+    FDelegateHandle ActorMovingDelegateHandle;
+    FDelegateHandle ObjectPropertyChangedDelegateHandle;
+    FDelegateHandle ObjectTransactedDelegateHandle;
+    FDelegateHandle ComponentCreatePhysicsDelegateHandle;
+    FDelegateHandle ComponentDestroyPhysicsDelegateHandle;
+    FDelegateHandle LevelAddedToWorldDelegateHandle;
+    FDelegateHandle LevelRemovedFromWorldDelegateHandle;
+
+    FDelegateHandle WorldCleanupDelegateHandle;
+    FDelegateHandle PostWorldInitializationDelegateHandle;
+
+    /** 書き込み統計を出力するコンソールコマンド */
+    IConsoleObject *DumpWriteStatsCommand = nullptr;
+
+    /** 表示が初めて有効になり、デリゲートの登録とマテリアルの読み込みを行ったかどうか */
+    bool bIsModuleActive = false;
+
+    /** テキストマテリアル（とGPUモードのビルボードマテリアル）の非同期読み込みのハンドル */
+    TSharedPtr<FStreamableHandle> TextMaterialLoadHandle;
+
+    /** テキストマテリアルの読み込みが完了したかどうか（失敗した場合も含む） */
+    bool bAreTextMaterialsLoaded = false;
+
+    /** TEXT_MATERIAL_PATHから読み込んだテキストマテリアル */
+    TObjectPtr<UMaterialInterface> TextBaseMaterial;
+
+    /**
+     * 全ラベルアクターで共有するマテリアルインスタンス。
+     * パラメータ（OutlineWidth）はすべてグローバル設定のため、インスタンスは1つで足りる。
+     */
+    TObjectPtr<UMaterialInstanceDynamic> SharedTextMaterial;
+
+    /** 共有マテリアルがビルボードマテリアルから作られ、CPUでの回転更新が不要かどうか */
+    bool bIsMaterialBillboardActive = false;
+
+    /** 予約済み処理の優先度付きヒープ（フレーム間でメモリを再利用する） */
+    TArray<FScheduledLabelWork> ScheduledLabelWork;
+
+    /** ワーカーへ渡すラベルのスナップショット（フレーム間でメモリを再利用する） */
+    FEditorActorTagDisplayLabelSnapshot LabelSnapshot;
+
+    /** 可視判定の結果（フレーム間でメモリを再利用する） */
+    TArray<AActor *> VisibleActorBuffer;
+
+    /** ビューごとの投影結果（フレーム間でメモリを再利用する） */
+    TArray<FProjectedOverlayLabel> ProjectedOverlayLabels;
+
+    /** 表示数の上限で選ばれた候補の最大ヒープ（フレーム間でメモリを再利用する） */
+    TArray<FRankedLabel> RankedLabelBuffer;
+
+    /** プロパティ種別ごとの書き込み統計 */
+    FWriteCounter TextWriteCounter;
+    FWriteCounter ColorWriteCounter;
+    FWriteCounter LocationWriteCounter;
+    FWriteCounter RotationWriteCounter;
+
+    /** UClassごとに一致したClassConfigsのインデックス、コンパイル済みのタグフィルター、解決済みの表示内容の取得元のキャッシュ */
+    FEditorActorTagDisplayConfigMatcher ConfigMatcher;
+
+    /** エディター・PIEのワールドの代わりにラベルを表示するワールド */
+    TWeakObjectPtr<UWorld> WorldOverride;
+
+    /** ラベルを表示するワールドの一覧（ワールドの初期化・破棄とPIEの開始・終了時のみ列挙し直す） */
+    TArray<TWeakObjectPtr<UWorld>, TInlineAllocator<4>> LabelWorlds;
+    bool bAreLabelWorldsDirty = true;
+
+    /** 次にプールのラベルアクターの期限切れを確認する時刻（FPlatformTime::Seconds） */
+    double NextPoolTrimTime = 0.0;
+
+    /** ワールドごとのラベルコンテキスト（デリゲートが参照するためアドレスを固定する） */
+    TMap<TObjectKey<UWorld>, TUniquePtr<FLabelContext>> LabelContexts;
 };
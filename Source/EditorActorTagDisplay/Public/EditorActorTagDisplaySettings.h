@@ -7,6 +7,79 @@
 #include "EditorActorTagDisplaySettings.generated.h"
 
 class AActor;
+class UMaterialInterface;
+
+/** ラベルの描画方式 */
+UENUM()
+enum class EEditorActorTagDisplayRenderMode : uint8
+{
+    /** ラベルごとにTextRenderComponentを持つアクターを生成する */
+    PerActor UMETA(DisplayName = "Per-Actor Text Render"),
+
+    /** 単一のプリミティブコンポーネントで全ラベルをまとめて描画する */
+    Batched UMETA(DisplayName = "Batched Primitive"),
+
+    /** UObjectを生成せず、すべてのレベルビューポートにスクリーン空間でキャンバス描画する */
+    CanvasOverlay UMETA(DisplayName = "Screen-Space Canvas Overlay"),
+};
+
+/** ラベルアクターをカメラに向ける方法 */
+UENUM()
+enum class EEditorActorTagDisplayFacingMode : uint8
+{
+    /** 毎フレームSetActorRotationでカメラに向ける */
+    CPU UMETA(DisplayName = "CPU (Actor Rotation)"),
+
+    /** マテリアルの頂点シェーダー（World Position Offset）でカメラに向ける */
+    GPU UMETA(DisplayName = "GPU (Material Billboard)"),
+};
+
+/** ラベルの基準位置の求め方 */
+UENUM()
+enum class EEditorActorTagDisplayAnchorSource : uint8
+{
+    /** コリジョンを持つコンポーネントのバウンディングボックスの上端中央 */
+    CollidingBounds UMETA(DisplayName = "Colliding Bounds"),
+
+    /** すべてのプリミティブコンポーネントのバウンディングボックスの上端中央 */
+    AllPrimitiveBounds UMETA(DisplayName = "All Primitive Bounds"),
+
+    /** ルートコンポーネントの位置 */
+    RootLocation UMETA(DisplayName = "Root Location"),
+
+    /** 指定した名前のソケットの位置 */
+    Socket UMETA(DisplayName = "Named Socket"),
+};
+
+/** ラベルに表示する内容の取得元 */
+UENUM()
+enum class EEditorActorTagDisplayLabelSourceType : uint8
+{
+    /** アクターのタグ */
+    ActorTags UMETA(DisplayName = "Actor Tags"),
+
+    /** すべてのコンポーネントのタグ */
+    ComponentTags UMETA(DisplayName = "Component Tags"),
+
+    /** プロパティの値（GameplayTagContainer・GameplayTag・名前の配列はタグとして、それ以外は「パス: 値」の行で表示する） */
+    Property UMETA(DisplayName = "Property"),
+};
+
+USTRUCT()
+struct EDITORACTORTAGDISPLAY_API FEditorActorTagDisplayLabelSource
+{
+    // NOLINTNEXTLINE
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, Category = "Label Source", meta = (DisplayName = "Source Type"))
+    EEditorActorTagDisplayLabelSourceType SourceType = EEditorActorTagDisplayLabelSourceType::ActorTags;
+
+    /** 「.」区切りのプロパティパス（例：「HealthComponent.MaxHealth」）。構造体とオブジェクト参照をたどる */
+    UPROPERTY(EditAnywhere, Category = "Label Source",
+              meta = (DisplayName = "Property Path",
+                      EditCondition = "SourceType == EEditorActorTagDisplayLabelSourceType::Property"))
+    FString PropertyPath;
+};
 
 USTRUCT()
 struct EDITORACTORTAGDISPLAY_API FActorClassTagDisplayConfig
@@ -22,6 +95,31 @@ struct EDITORACTORTAGDISPLAY_API FActorClassTagDisplayConfig
 
     UPROPERTY(EditAnywhere, Category = "Actor Class Tag Display", meta = (DisplayName = "Position Offset"))
     FVector PositionOffset = FVector::ZeroVector;
+
+    UPROPERTY(EditAnywhere, Category = "Actor Class Tag Display", meta = (DisplayName = "Anchor Source"))
+    EEditorActorTagDisplayAnchorSource AnchorSource = EEditorActorTagDisplayAnchorSource::CollidingBounds;
+
+    UPROPERTY(EditAnywhere, Category = "Actor Class Tag Display",
+              meta = (DisplayName = "Anchor Socket Name",
+                      EditCondition = "AnchorSource == EEditorActorTagDisplayAnchorSource::Socket"))
+    FName AnchorSocketName;
+
+    /** 表示するタグ（完全一致、「Prefix*」で前方一致、「*」「?」でワイルドカード。空の場合はすべて表示） */
+    UPROPERTY(EditAnywhere, Category = "Actor Class Tag Display", meta = (DisplayName = "Include Tag Patterns"))
+    TArray<FString> IncludeTagPatterns;
+
+    /** 表示しないタグ（Include Tag Patternsより優先） */
+    UPROPERTY(EditAnywhere, Category = "Actor Class Tag Display", meta = (DisplayName = "Exclude Tag Patterns"))
+    TArray<FString> ExcludeTagPatterns;
+
+    /** ラベルに表示する内容（上から順に表示する。空の場合はアクターのタグのみ。タグはすべて上記のパターンで絞り込む） */
+    UPROPERTY(EditAnywhere, Category = "Actor Class Tag Display", meta = (DisplayName = "Label Sources"))
+    TArray<FEditorActorTagDisplayLabelSource> LabelSources;
+
+    /** 表示数の上限に達したときの優先度（カメラからの距離をこの値で割って比較し、小さいものから表示する） */
+    UPROPERTY(EditAnywhere, Category = "Actor Class Tag Display",
+              meta = (DisplayName = "Label Priority", ClampMin = "0.01"))
+    float LabelPriority = 1.0F;
 };
 
 UCLASS(config = EditorPerProjectUserSettings, meta = (DisplayName = "Actor Tag Display"))
@@ -38,18 +136,41 @@ public:
     auto GetCategoryName() const -> FName override { return {"Plugins"}; }
     auto GetSectionName() const -> FName override { return {"EditorActorTagDisplay"}; }
 
+    // UObject overrides
+    auto PostInitProperties() -> void override;
 #if WITH_EDITOR
     auto PostEditChangeProperty(FPropertyChangedEvent &PropertyChangedEvent) -> void override;
 #endif
 
     // 設定値へのアクセサ
     auto GetClassConfigs() const -> const TArray<FActorClassTagDisplayConfig> & { return ClassConfigs; }
+    // bSaveToConfigがfalseの場合はiniに保存せず、メモリ上の値のみ変更する（ベンチマークなどの一時的な差し替え用）
+    auto SetClassConfigs(const TArray<FActorClassTagDisplayConfig> &InClassConfigs, bool bSaveToConfig = true) -> void;
     auto IsTagDisplayEnabled() const -> bool { return bIsTagDisplayEnabled; }
-    auto SetTagDisplayEnabled(bool bEnabled) -> void;
+    auto SetTagDisplayEnabled(bool bEnabled, bool bSaveToConfig = true) -> void;
     auto GetTextSize() const -> float { return TextSize; }
     auto SetTextSize(float InTextSize) -> void;
     auto GetOutlineWidth() const -> float { return OutlineWidth; }
     auto SetOutlineWidth(float InOutlineWidth) -> void;
+    auto IsIncrementalUpdateEnabled() const -> bool { return bUseIncrementalUpdate; }
+    auto GetRenderMode() const -> EEditorActorTagDisplayRenderMode { return RenderMode; }
+    auto GetMaxPooledLabels() const -> int32 { return MaxPooledLabels; }
+    auto GetFacingMode() const -> EEditorActorTagDisplayFacingMode
+    {
+        // ビルボードマテリアルが未設定の間はGPUモードを使えない
+        return BillboardTextMaterial.IsNull() ? EEditorActorTagDisplayFacingMode::CPU : FacingMode;
+    }
+    auto IsViewCullingEnabled() const -> bool { return bEnableViewCulling; }
+    auto GetMaxLabelDistance() const -> float { return MaxLabelDistance; }
+    auto GetMaxVisibleLabels() const -> int32 { return MaxVisibleLabels; }
+    auto GetUpdateBudgetMs() const -> float { return UpdateBudgetMs; }
+    auto GetFarLabelDistance() const -> float { return FarLabelDistance; }
+    auto GetFarLabelRefreshInterval() const -> int32 { return FarLabelRefreshInterval; }
+    auto GetBillboardTextMaterial() const -> const TSoftObjectPtr<UMaterialInterface> &
+    {
+        return BillboardTextMaterial;
+    }
+    auto GetPooledLabelGracePeriod() const -> float { return PooledLabelGracePeriod; }
 
     // 静的アクセサ
     static auto Get() -> UEditorActorTagDisplaySettings *;
@@ -57,18 +178,34 @@ public:
     // デリゲート宣言
     DECLARE_MULTICAST_DELEGATE_OneParam(FOnTextSizeChanged, float);
     DECLARE_MULTICAST_DELEGATE_OneParam(FOnOutlineWidthChanged, float);
+    DECLARE_MULTICAST_DELEGATE(FOnClassConfigsChanged);
+    DECLARE_MULTICAST_DELEGATE(FOnTextMaterialChanged);
+    DECLARE_MULTICAST_DELEGATE_OneParam(FOnTagDisplayEnabledChanged, bool);
 
     // デリゲートアクセサ（モジュール用）
     auto GetOnTextSizeChangedDelegate() -> FOnTextSizeChanged & { return OnTextSizeChanged; }
     auto GetOnOutlineWidthChangedDelegate() -> FOnOutlineWidthChanged & { return OnOutlineWidthChanged; }
+    auto GetOnClassConfigsChangedDelegate() -> FOnClassConfigsChanged & { return OnClassConfigsChanged; }
+    auto GetOnTextMaterialChangedDelegate() -> FOnTextMaterialChanged & { return OnTextMaterialChanged; }
+    auto GetOnTagDisplayEnabledChangedDelegate() -> FOnTagDisplayEnabledChanged & { return OnTagDisplayEnabledChanged; }
 
 private:
     // デリゲートインスタンス
     FOnTextSizeChanged OnTextSizeChanged;
     FOnOutlineWidthChanged OnOutlineWidthChanged;
+    FOnClassConfigsChanged OnClassConfigsChanged;
+    FOnTextMaterialChanged OnTextMaterialChanged;
+    FOnTagDisplayEnabledChanged OnTagDisplayEnabledChanged;
 
     static constexpr float DefaultTextSize = 30.0F;
     static constexpr float DefaultOutlineWidth = 10.0F;
+    static constexpr int32 DefaultMaxPooledLabels = 256;
+    static constexpr float DefaultPooledLabelGracePeriod = 5.0F;
+    static constexpr float DefaultMaxLabelDistance = 20000.0F;
+    static constexpr int32 DefaultMaxVisibleLabels = 1000;
+    static constexpr float DefaultUpdateBudgetMs = 0.5F;
+    static constexpr float DefaultFarLabelDistance = 5000.0F;
+    static constexpr int32 DefaultFarLabelRefreshInterval = 8;
 
     UPROPERTY(config, EditAnywhere, Category = "Actor Tag Display", meta = (DisplayName = "Class Configurations"))
     TArray<FActorClassTagDisplayConfig> ClassConfigs;
@@ -81,4 +218,70 @@ private:
 
     UPROPERTY(config, EditAnywhere, Category = "Actor Tag Display", meta = (DisplayName = "Outline Width"))
     float OutlineWidth = DefaultOutlineWidth;
+
+    /** 有効な場合、毎フレームの全アクター走査の代わりにイベント駆動で変更のあったアクターのみを処理する */
+    UPROPERTY(config, EditAnywhere, Category = "Performance", meta = (DisplayName = "Incremental Update"))
+    bool bUseIncrementalUpdate = true;
+
+    /** ラベルの描画方式 */
+    UPROPERTY(config, EditAnywhere, Category = "Performance", meta = (DisplayName = "Render Mode"))
+    EEditorActorTagDisplayRenderMode RenderMode = EEditorActorTagDisplayRenderMode::PerActor;
+
+    /** 再利用のために非表示で保持しておくラベルアクターの上限数 */
+    UPROPERTY(config, EditAnywhere, Category = "Performance",
+              meta = (DisplayName = "Max Pooled Labels", ClampMin = "0"))
+    int32 MaxPooledLabels = DefaultMaxPooledLabels;
+
+    /** プールに戻されたラベルアクターを実際に破棄するまでの猶予時間（秒） */
+    UPROPERTY(config, EditAnywhere, Category = "Performance",
+              meta = (DisplayName = "Pooled Label Grace Period", ClampMin = "0.0", Units = "s"))
+    float PooledLabelGracePeriod = DefaultPooledLabelGracePeriod;
+
+    /**
+     * GPUモードで使用する、頂点シェーダーでカメラ方向に向けるテキストマテリアル（プラグインには含まれない）。
+     * 設定するまでGPUモードは選択できず、読み込みに失敗した場合はCPUモードにフォールバックする。
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Performance", meta = (DisplayName = "Billboard Text Material"))
+    TSoftObjectPtr<UMaterialInterface> BillboardTextMaterial;
+
+    /** ラベルアクターをカメラに向ける方法（Per-Actor描画方式のみ） */
+    UPROPERTY(config, EditAnywhere, Category = "Performance",
+              meta = (DisplayName = "Label Facing Mode", EditCondition = "bHasBillboardTextMaterial",
+                      EditConditionHides))
+    EEditorActorTagDisplayFacingMode FacingMode = EEditorActorTagDisplayFacingMode::CPU;
+
+    /** ビルボードマテリアルが設定されているか（FacingModeの表示条件） */
+    UPROPERTY(Transient)
+    bool bHasBillboardTextMaterial = false;
+
+    /** 有効な場合、カメラの視錐台内かつ最大距離以内のアクターにのみラベルを生成する（Incremental Update時のみ） */
+    UPROPERTY(config, EditAnywhere, Category = "Performance", meta = (DisplayName = "Enable View Culling"))
+    bool bEnableViewCulling = true;
+
+    /** ラベルを表示する最大距離（0以下で無制限） */
+    UPROPERTY(config, EditAnywhere, Category = "Performance",
+              meta = (DisplayName = "Max Label Distance", Units = "cm", EditCondition = "bEnableViewCulling"))
+    float MaxLabelDistance = DefaultMaxLabelDistance;
+
+    /**
+     * 1つのビューに同時に表示するラベルの上限（0以下で無制限）。ラベルの表示位置がカメラに近い順（Label Priorityで
+     * 重み付け）に選び、上限を超えたラベルは描画リソースを解放する。カリングの有無・投影方式・更新方式によらず有効で、
+     * キャンバス描画ではビューごとに適用する。カメラを持たないワールドでは適用せず、その旨をログに出力する。
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Performance",
+              meta = (DisplayName = "Max Visible Labels", ClampMin = "0"))
+    int32 MaxVisibleLabels = DefaultMaxVisibleLabels;
+
+    /** ラベルの生成・更新に1フレームあたり使う時間の上限（0以下で無制限、Incremental Update時のみ） */
+    UPROPERTY(config, EditAnywhere, Category = "Performance", meta = (DisplayName = "Update Budget", Units = "ms"))
+    float UpdateBudgetMs = DefaultUpdateBudgetMs;
+
+    /** この距離より遠いラベルは向きの更新を間引く */
+    UPROPERTY(config, EditAnywhere, Category = "Performance", meta = (DisplayName = "Far Label Distance", Units = "cm"))
+    float FarLabelDistance = DefaultFarLabelDistance;
+
+    /** 遠いラベルの向きを更新するフレーム間隔 */
+    UPROPERTY(config, EditAnywhere, Category = "Performance",
+              meta = (DisplayName = "Far Label Refresh Interval", ClampMin = "1"))
+    int32 FarLabelRefreshInterval = DefaultFarLabelRefreshInterval;
 };
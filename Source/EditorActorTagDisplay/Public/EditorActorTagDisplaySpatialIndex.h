@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// 前方宣言
+class AActor;
+struct FConvexVolume;
+
+// 追跡中のアクターのラベル基準位置を格納するハッシュグリッド（視界内のラベルのみを生成するために使う）
+class EDITORACTORTAGDISPLAY_API FEditorActorTagDisplaySpatialIndex
+{
+public:
+    static constexpr double DefaultCellSize = 5000.0;
+
+    explicit FEditorActorTagDisplaySpatialIndex(double InCellSize = DefaultCellSize);
+
+    // 登録・削除
+    auto Update(AActor *Actor, const FVector &Position) -> void;
+    auto Remove(const TWeakObjectPtr<AActor> &Actor) -> void;
+    auto Reset() -> void;
+    auto Num() const -> int32 { return Elements.Num(); }
+
+    /** 視錐台内かつ視点からMaxDistance以内のアクターを集める（MaxDistanceが0以下なら距離で絞らない） */
+    auto QueryView(const FConvexVolume &Frustum, const FVector &ViewOrigin, double MaxDistance, double ElementRadius,
+                   TArray<AActor *> &OutActors) const -> void;
+
+    /** カリングしない場合に、登録されているすべてのアクターを集める */
+    auto GatherAll(TArray<AActor *> &OutActors) const -> void;
+
+private:
+    struct FElement
+    {
+        TWeakObjectPtr<AActor> Actor;
+        FVector Position = FVector::ZeroVector;
+        FIntVector Cell = FIntVector::ZeroValue;
+    };
+
+    // セル操作
+    auto GetCell(const FVector &Position) const -> FIntVector;
+    auto GetCellBox(const FIntVector &Cell) const -> FBox;
+    auto RemoveFromCell(int32 ElementIndex, const FIntVector &Cell) -> void;
+    auto GatherCell(const FIntVector &Cell, const TArray<int32> &CellElements, const FConvexVolume &Frustum,
+                    const FVector &ViewOrigin, double MaxDistanceSquared, double ElementRadius,
+                    TArray<AActor *> &OutActors) const -> void;
+
+    /** セルの1辺の長さ */
+    double CellSize;
+
+    /** 要素番号で参照する登録済みのアクター */
+    TSparseArray<FElement> Elements;
+
+    /** アクターごとの要素番号 */
+    TMap<TWeakObjectPtr<AActor>, int32> ElementIndices;
+
+    /** 要素を持つセルごとの要素番号 */
+    TMap<FIntVector, TArray<int32>> Cells;
+};
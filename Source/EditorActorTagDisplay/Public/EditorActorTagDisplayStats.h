@@ -0,0 +1,65 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+// NOLINTNEXTLINE
+DECLARE_STATS_GROUP(TEXT("EditorActorTagDisplay"), STATGROUP_EditorActorTagDisplay, STATCAT_Advanced);
+
+// 各処理段階の所要時間
+// NOLINTBEGIN
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Text Actors"), STAT_EditorActorTagDisplay_Update,
+                          STATGROUP_EditorActorTagDisplay, EDITORACTORTAGDISPLAY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Process Actors In World"), STAT_EditorActorTagDisplay_ProcessActorsInWorld,
+                          STATGROUP_EditorActorTagDisplay, EDITORACTORTAGDISPLAY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Sweep Tracked World"), STAT_EditorActorTagDisplay_SweepTrackedWorld,
+                          STATGROUP_EditorActorTagDisplay, EDITORACTORTAGDISPLAY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Process Dirty Actors"), STAT_EditorActorTagDisplay_ProcessDirtyActors,
+                          STATGROUP_EditorActorTagDisplay, EDITORACTORTAGDISPLAY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Refresh Rotations"), STAT_EditorActorTagDisplay_RefreshRotations,
+                          STATGROUP_EditorActorTagDisplay, EDITORACTORTAGDISPLAY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Materialize Visible Labels"), STAT_EditorActorTagDisplay_MaterializeVisibleLabels,
+                          STATGROUP_EditorActorTagDisplay, EDITORACTORTAGDISPLAY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Drain Label Work"), STAT_EditorActorTagDisplay_DrainLabelWork,
+                          STATGROUP_EditorActorTagDisplay, EDITORACTORTAGDISPLAY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build Label Snapshot"), STAT_EditorActorTagDisplay_BuildSnapshot,
+                          STATGROUP_EditorActorTagDisplay, EDITORACTORTAGDISPLAY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Create Or Update Text Actor"), STAT_EditorActorTagDisplay_CreateOrUpdateTextActor,
+                          STATGROUP_EditorActorTagDisplay, EDITORACTORTAGDISPLAY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Get Or Create Text Actor"), STAT_EditorActorTagDisplay_GetOrCreateTextActor,
+                          STATGROUP_EditorActorTagDisplay, EDITORACTORTAGDISPLAY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Remove Unused Text Actors"), STAT_EditorActorTagDisplay_RemoveUnusedTextActors,
+                          STATGROUP_EditorActorTagDisplay, EDITORACTORTAGDISPLAY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Draw Canvas Overlay"), STAT_EditorActorTagDisplay_DrawCanvasOverlay,
+                          STATGROUP_EditorActorTagDisplay, EDITORACTORTAGDISPLAY_API);
+
+// 現在の状態（フレームごとに設定する）
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Tracked Actors"), STAT_EditorActorTagDisplay_TrackedActors,
+                                      STATGROUP_EditorActorTagDisplay, EDITORACTORTAGDISPLAY_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live Labels"), STAT_EditorActorTagDisplay_LiveLabels,
+                                      STATGROUP_EditorActorTagDisplay, EDITORACTORTAGDISPLAY_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pooled Label Actors"), STAT_EditorActorTagDisplay_PooledLabels,
+                                      STATGROUP_EditorActorTagDisplay, EDITORACTORTAGDISPLAY_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pending Label Work"), STAT_EditorActorTagDisplay_PendingLabelWork,
+                                      STATGROUP_EditorActorTagDisplay, EDITORACTORTAGDISPLAY_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Label UObjects"), STAT_EditorActorTagDisplay_LabelObjects,
+                                      STATGROUP_EditorActorTagDisplay, EDITORACTORTAGDISPLAY_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Material Instances"), STAT_EditorActorTagDisplay_MaterialInstances,
+                                      STATGROUP_EditorActorTagDisplay, EDITORACTORTAGDISPLAY_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Text Mesh Vertices"), STAT_EditorActorTagDisplay_TextMeshVertices,
+                                      STATGROUP_EditorActorTagDisplay, EDITORACTORTAGDISPLAY_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Shared Glyph Layouts (Batched)"),
+                                      STAT_EditorActorTagDisplay_SharedGlyphLayouts, STATGROUP_EditorActorTagDisplay,
+                                      EDITORACTORTAGDISPLAY_API);
+
+// フレーム内の発生回数（フレームごとにリセットされる）
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Label Actor Spawns"), STAT_EditorActorTagDisplay_Spawns,
+                                  STATGROUP_EditorActorTagDisplay, EDITORACTORTAGDISPLAY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Label Actor Destroys"), STAT_EditorActorTagDisplay_Destroys,
+                                  STATGROUP_EditorActorTagDisplay, EDITORACTORTAGDISPLAY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Text Rebuilds"), STAT_EditorActorTagDisplay_TextRebuilds,
+                                  STATGROUP_EditorActorTagDisplay, EDITORACTORTAGDISPLAY_API);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(EDITORACTORTAGDISPLAY_API, EditorActorTagDisplay);
+// NOLINTEND
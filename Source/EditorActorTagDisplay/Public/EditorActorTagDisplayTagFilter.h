@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// クラス設定ごとの表示・除外タグのルール（設定の変更時に一度だけコンパイルする）
+// 完全一致はFNameで比較し、前方一致・ワイルドカードの判定結果はタグごとにキャッシュする（大文字・小文字は区別しない）
+class EDITORACTORTAGDISPLAY_API FEditorActorTagDisplayTagFilter
+{
+public:
+    FEditorActorTagDisplayTagFilter() = default;
+    FEditorActorTagDisplayTagFilter(TConstArrayView<FString> IncludePatterns, TConstArrayView<FString> ExcludePatterns);
+
+    /** ルールがなく、すべてのタグを表示するか */
+    auto IsEmpty() const -> bool { return Include.IsEmpty() && Exclude.IsEmpty(); }
+
+    // 判定
+    auto PassesTag(FName Tag) -> bool;
+    auto PassesAny(TConstArrayView<FName> Tags) -> bool;
+
+    /** 表示するタグを順序を保って追加し、追加した数を返す */
+    auto AppendPassingTags(TConstArrayView<FName> Tags, TArray<FName> &OutTags) -> int32;
+
+private:
+    /** 表示・除外の一方のコンパイル済みパターン */
+    struct FRuleSet
+    {
+        TSet<FName> ExactNames;
+        TArray<FString> Prefixes;
+        TArray<FString> Wildcards;
+
+        auto IsEmpty() const -> bool { return ExactNames.IsEmpty() && Prefixes.IsEmpty() && Wildcards.IsEmpty(); }
+        auto HasStringRules() const -> bool { return !Prefixes.IsEmpty() || !Wildcards.IsEmpty(); }
+        auto Add(const FString &Pattern) -> void;
+        auto MatchesString(const FString &TagString) const -> bool;
+    };
+
+    /** キャッシュにないタグをルールで判定する */
+    auto Evaluate(FName Tag) const -> bool;
+
+    FRuleSet Include;
+    FRuleSet Exclude;
+
+    /** 前方一致・ワイルドカードで判定したタグの結果 */
+    TMap<FName, bool> Decisions;
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "EditorActorTagDisplayTagIndexExportCommandlet.generated.h"
+
+// 前方宣言
+class UWorld;
+class FEditorActorTagDisplayConfigMatcher;
+struct FActorClassTagDisplayConfig;
+
+// マップごとにラベルを表示するタグ付きアクターの一覧を書き出すCI向けのコマンドレット
+// 後続のマップを非同期に読み込みながら1つずつ処理し、GCInterval件ごとに処理済みのマップを解放する
+// 読み込まれたレベルのみが対象で、World Partitionのマップは部分的な結果となる（-AllowPartialがなければ失敗扱い）
+//
+// 使い方: UnrealEditor-Cmd <Project> -run=EditorActorTagDisplayTagIndexExport -nullrhi -unattended
+//        (-Maps=/Game/A,/Game/B | -MapList=<file> | -AllMaps) [-Output=<dir>] [-Json] [-Prefetch=2] [-GCInterval=16]
+//        [-AllowPartial]
+//
+// バイナリ形式（<Map>.tagindex）: マジック、バージョン、クラスパスとタグの文字列テーブル、
+// アクターごとのワールドからの相対パス・クラスの文字列番号・設定番号・タグの文字列番号・基準位置（FVector3f）
+UCLASS()
+class EDITORACTORTAGDISPLAY_API UEditorActorTagDisplayTagIndexExportCommandlet : public UCommandlet
+{
+    // NOLINTNEXTLINE
+    GENERATED_BODY()
+
+public:
+    UEditorActorTagDisplayTagIndexExportCommandlet();
+
+    // UCommandlet overrides
+    auto Main(const FString &Params) -> int32 override;
+
+    /** バイナリ形式の識別子（ファイル上のバイト順で"ETIX"） */
+    static constexpr uint32 BinaryMagic = 0x58495445;
+    static constexpr uint32 BinaryVersion = 1;
+
+private:
+    /** 読み込んだワールドの一覧をOutputDirectoryに書き出し、書き出したアクター数を返す（失敗時はINDEX_NONE） */
+    static auto ExportWorld(UWorld *World, const FString &PackageName,
+                            FEditorActorTagDisplayConfigMatcher &ConfigMatcher,
+                            const TArray<FActorClassTagDisplayConfig> &ClassConfigs, const FString &OutputDirectory,
+                            bool bWriteJson) -> int32;
+
+    static constexpr int32 DefaultPrefetch = 2;
+    static constexpr int32 MaxPrefetch = 16;
+    static constexpr int32 DefaultGCInterval = 16;
+};
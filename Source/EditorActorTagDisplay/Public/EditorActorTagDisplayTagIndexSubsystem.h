@@ -0,0 +1,132 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorSubsystem.h"
+#include "EditorActorTagDisplayTagIndexSubsystem.generated.h"
+
+// 前方宣言
+class AActor;
+class ULevel;
+class UWorld;
+class FTransactionObjectEvent;
+struct FPropertyChangedEvent;
+
+// タグからアクターを引く転置インデックスをワールドごとに保持するサブシステム（ラベルの表示とは独立）
+// 最初の問い合わせでレベルごとに作り、以降はアクター・プロパティ・Undo/Redo・レベルストリーミングのイベントで差分更新する
+//
+// Python: unreal.get_editor_subsystem(unreal.EditorActorTagDisplayTagIndexSubsystem).find_actors_with_tag("Tag")
+UCLASS()
+class EDITORACTORTAGDISPLAY_API UEditorActorTagDisplayTagIndexSubsystem : public UEditorSubsystem
+{
+    // NOLINTNEXTLINE
+    GENERATED_BODY()
+
+public:
+    /** サブシステムを取得する（エディタ外ではnullptr） */
+    static auto Get() -> UEditorActorTagDisplayTagIndexSubsystem *;
+
+    // USubsystem overrides
+    auto Initialize(FSubsystemCollectionBase &Collection) -> void override;
+    auto Deinitialize() -> void override;
+
+    /** エディタワールドでタグを持つアクターを返す */
+    UFUNCTION(BlueprintCallable, Category = "Editor Actor Tag Display|Tag Index")
+    TArray<AActor *> FindActorsWithTag(FName Tag);
+
+    /** エディタワールドでタグを持つアクター数を返す */
+    UFUNCTION(BlueprintCallable, Category = "Editor Actor Tag Display|Tag Index")
+    int32 CountActorsWithTag(FName Tag);
+
+    /** エディタワールドですべてのタグを持つアクターを返す */
+    UFUNCTION(BlueprintCallable, Category = "Editor Actor Tag Display|Tag Index")
+    TArray<AActor *> FindActorsWithAllTags(const TArray<FName> &Tags);
+
+    /** エディタワールドでいずれかのタグを持つアクターを返す */
+    UFUNCTION(BlueprintCallable, Category = "Editor Actor Tag Display|Tag Index")
+    TArray<AActor *> FindActorsWithAnyTag(const TArray<FName> &Tags);
+
+    /** エディタワールドのアクターが持つすべてのタグを返す */
+    UFUNCTION(BlueprintCallable, Category = "Editor Actor Tag Display|Tag Index")
+    TArray<FName> GetAllTags();
+
+    /** すべてのタグを持つアクターを選択し、必要ならビューポートに映して、選択したアクター数を返す */
+    UFUNCTION(BlueprintCallable, Category = "Editor Actor Tag Display|Tag Index")
+    int32 SelectActorsWithAllTags(const TArray<FName> &Tags, bool bFocusViewports = true);
+
+    // ワールドを指定した問い合わせ
+    auto FindActorsWithTagInWorld(UWorld *World, FName Tag, TArray<AActor *> &OutActors) -> void;
+
+    auto FindActorsWithAllTagsInWorld(UWorld *World, TConstArrayView<FName> Tags, TArray<AActor *> &OutActors) -> void;
+
+    auto FindActorsWithAnyTagInWorld(UWorld *World, TConstArrayView<FName> Tags, TArray<AActor *> &OutActors) -> void;
+
+    auto CountActorsWithTagInWorld(UWorld *World, FName Tag) -> int32;
+
+private:
+    /** アクターを登録したタグとレベル */
+    struct FIndexedActor
+    {
+        TArray<FName, TInlineAllocator<4>> Tags;
+        TObjectKey<ULevel> Level;
+    };
+
+    /** 登録済みのレベルと、World Partitionの読み込みイベントの購読 */
+    struct FIndexedLevel
+    {
+        TWeakObjectPtr<ULevel> Level;
+        TSet<TWeakObjectPtr<AActor>> Actors;
+        FDelegateHandle LoadedActorAddedHandle;
+        FDelegateHandle LoadedActorRemovedHandle;
+    };
+
+    /** 1つのワールドのインデックス */
+    struct FWorldTagIndex
+    {
+        TMap<FName, TSet<TWeakObjectPtr<AActor>>> ActorsByTag;
+        TMap<TWeakObjectPtr<AActor>, FIndexedActor> IndexedActors;
+        TMap<TObjectKey<ULevel>, FIndexedLevel> IndexedLevels;
+    };
+
+    /** BlueprintとPythonのAPIで問い合わせるワールドを取得する */
+    static auto GetEditorWorld() -> UWorld *;
+
+    /** ワールドのインデックスを取得する（初回に作る） */
+    auto GetOrBuildWorldIndex(UWorld *World) -> FWorldTagIndex *;
+    auto RemoveWorldIndex(const TObjectKey<UWorld> &WorldKey) -> void;
+
+    // レベル単位の登録・削除
+    auto IndexLevel(FWorldTagIndex &Index, ULevel *Level) -> void;
+    auto UnindexLevel(FWorldTagIndex &Index, const TObjectKey<ULevel> &LevelKey) -> void;
+
+    /** アクターの登録を現在のタグに合わせる */
+    auto ReindexActor(AActor *Actor) -> void;
+    auto ReindexActor(FWorldTagIndex &Index, AActor *Actor) -> void;
+    auto UnindexActor(FWorldTagIndex &Index, const TWeakObjectPtr<AActor> &Actor) -> void;
+
+    /** まだタグを持っている有効なアクターを追加する */
+    static auto AppendLiveActors(const TSet<TWeakObjectPtr<AActor>> &Actors, FName Tag, TArray<AActor *> &OutActors)
+        -> void;
+
+    // イベントハンドラ
+    auto OnLevelActorAdded(AActor *Actor) -> void;
+    auto OnLevelActorDeleted(AActor *Actor) -> void;
+    auto OnObjectPropertyChanged(UObject *Object, FPropertyChangedEvent &PropertyChangedEvent) -> void;
+    auto OnObjectTransacted(UObject *Object, const FTransactionObjectEvent &TransactionEvent) -> void;
+    auto OnLevelAddedToWorld(ULevel *Level, UWorld *World) -> void;
+    auto OnLevelRemovedFromWorld(ULevel *Level, UWorld *World) -> void;
+    auto OnLoadedActorAdded(AActor &Actor) -> void;
+    auto OnLoadedActorRemoved(AActor &Actor) -> void;
+    auto OnWorldCleanup(UWorld *World, bool bSessionEnded, bool bCleanupResources) -> void;
+
+    /** ワールドごとのインデックス（最初の問い合わせで追加する） */
+    TMap<TObjectKey<UWorld>, FWorldTagIndex> WorldIndices;
+
+    // デリゲートハンドル
+    FDelegateHandle LevelActorAddedDelegateHandle;
+    FDelegateHandle LevelActorDeletedDelegateHandle;
+    FDelegateHandle ObjectPropertyChangedDelegateHandle;
+    FDelegateHandle ObjectTransactedDelegateHandle;
+    FDelegateHandle LevelAddedToWorldDelegateHandle;
+    FDelegateHandle LevelRemovedFromWorldDelegateHandle;
+    FDelegateHandle WorldCleanupDelegateHandle;
+};